@@ -0,0 +1,370 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <ysEvent.hpp>
+#include <ysKeyedEvent.hpp>
+#include <ysCoalescingEvent.hpp>
+#include <ysEventTrace.hpp>
+
+using namespace std;
+using namespace YS;
+
+// 결과는 JSON 한 개로 표준 출력에 쓴다.
+// 각 시나리오는 고정된 반복 횟수로 여러 번 측정해 최솟값과 중앙값을 기록한다.
+// 사용법 : ysEventBench [필터 문자열]
+
+namespace
+{
+    constexpr int Repetitions = 7;
+    constexpr size_t ListenerCounts[] = { 1, 10, 100, 10000 };
+
+    int volatile g_sink = 0;
+
+    class listener
+    {
+    public:
+        void OnEvent(int i) { g_sink = g_sink + i; }
+        void OnEventConst(int i) const { g_sink = g_sink + i; }
+        int Get(int i) const { return i + 1; }
+    };
+
+    void OnEvent(int i) { g_sink = g_sink + i; }
+
+    struct Result
+    {
+        string name;
+        size_t nListener;
+        size_t nIteration;
+        double minNs;
+        double medianNs;
+    };
+
+    vector<Result> g_results;
+    char const *g_pFilter = nullptr;
+
+    bool IsSelected(string const &name) { return g_pFilter == nullptr || name.find(g_pFilter) != string::npos; }
+
+    /**
+     * @brief fn을 nIteration번 호출하는 데 걸린 시간을 Repetitions번 측정해 기록
+     *
+     * @param setup 매 측정 전에 호출되는 준비 함수, 측정 시간에 포함되지 않는다.
+     * @param fn 측정할 함수
+     */
+    template <class _Setup, class _Fn>
+    void Measure(string const &name, size_t nListener, size_t nIteration, _Setup &&setup, _Fn &&fn)
+    {
+        if (!IsSelected(name))
+            return;
+        vector<double> samples;
+        for (int rep = 0; rep < Repetitions; ++rep)
+        {
+            setup();
+            auto begin = chrono::steady_clock::now();
+            for (size_t i = 0; i < nIteration; ++i)
+                fn();
+            auto end = chrono::steady_clock::now();
+            samples.push_back(chrono::duration<double, nano>(end - begin).count() / static_cast<double>(nIteration));
+        }
+        sort(samples.begin(), samples.end());
+        g_results.push_back({ name, nListener, nIteration, samples.front(), samples[samples.size() / 2] });
+    }
+    template <class _Fn>
+    void Measure(string const &name, size_t nListener, size_t nIteration, _Fn &&fn)
+    {
+        Measure(name, nListener, nIteration, [] {}, std::forward<_Fn>(fn));
+    }
+    /**
+     * @brief 호출 한 번에 약 100만 번의 리스너 호출이 일어나도록 반복 횟수를 정한다.
+     */
+    size_t IterationFor(size_t nListener) { return max<size_t>(1, 1000000 / nListener); }
+
+    void BenchDispatch()
+    {
+        for (size_t n : ListenerCounts)
+        {
+            Event<void(int)> e;
+            for (size_t i = 0; i < n; ++i)
+                e += OnEvent;
+            Measure("dispatch/free", n, IterationFor(n), [&] { e(1); });
+        }
+        for (size_t n : ListenerCounts)
+        {
+            vector<shared_ptr<listener>> owners;
+            Event<void(int)> e;
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener(owners.emplace_back(make_shared<listener>()), &listener::OnEvent);
+            Measure("dispatch/member", n, IterationFor(n), [&] { e(1); });
+        }
+        for (size_t n : ListenerCounts)
+        {
+            vector<shared_ptr<listener const>> owners;
+            Event<void(int)> e;
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener(owners.emplace_back(make_shared<listener const>()), &listener::OnEventConst);
+            Measure("dispatch/const_member", n, IterationFor(n), [&] { e(1); });
+        }
+        for (size_t n : ListenerCounts)
+        {
+            vector<listener> owners(n);
+            Event<void(int)> e;
+            for (auto &owner : owners)
+                e.AddListener(owner, &listener::OnEvent);
+            Measure("dispatch/raw_member", n, IterationFor(n), [&] { e(1); });
+        }
+        for (size_t n : ListenerCounts)
+        {
+            Event<void(int)> e;
+            int local = 0;
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener([&local](int v) { local += v; });
+            Measure("dispatch/callable", n, IterationFor(n), [&] { e(1); });
+            g_sink = g_sink + local;
+        }
+    }
+
+    void BenchChurn()
+    {
+        constexpr size_t n = 1000;
+        vector<ListenerHandle> handles(n);
+        Event<void(int)> e;
+        Measure("churn/add_remove_handle", n, 200, [&]
+        {
+            for (size_t i = 0; i < n; ++i)
+                handles[i] = e.AddListener(OnEvent);
+            for (size_t i = 0; i < n; ++i)
+                e.RemoveListener(handles[i]);
+        });
+        vector<shared_ptr<listener>> owners;
+        for (size_t i = 0; i < n; ++i)
+            owners.push_back(make_shared<listener>());
+        Measure("churn/add_remove_value", n, 20, [&]
+        {
+            for (auto &pOwner : owners)
+                e.AddListener(pOwner, &listener::OnEvent);
+            for (auto &pOwner : owners)
+                e.RemoveListener(pOwner, &listener::OnEvent);
+        });
+    }
+
+    void BenchExpiredOwners()
+    {
+        // 소유 객체 10개 중 9개가 소멸된 상태에서 처음 호출하는 비용과 정리된 뒤 다시 호출하는 비용
+        constexpr size_t n = 10000;
+        Event<void(int)> e;
+        vector<shared_ptr<listener>> owners;
+        auto setup = [&]
+        {
+            e.RemoveAllListener();
+            owners.clear();
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener(owners.emplace_back(make_shared<listener>()), &listener::OnEvent);
+            erase_if(owners, [i = size_t(0)](auto const &) mutable { return i++ % 10 != 0; });
+        };
+        Measure("expired/first_fire", n, 1, setup, [&] { e(1); });
+        setup();
+        e(1);
+        Measure("expired/after_compact", n, IterationFor(n), [&] { e(1); });
+    }
+
+    void BenchCopy()
+    {
+        for (size_t n : ListenerCounts)
+        {
+            vector<shared_ptr<listener>> owners;
+            Event<void(int)> e;
+            for (size_t i = 0; i < n; ++i)
+            {
+                e += OnEvent;
+                e.AddListener(owners.emplace_back(make_shared<listener>()), &listener::OnEvent);
+            }
+            Measure("copy/construct", 2 * n, max<size_t>(1, 100000 / n), [&]
+            {
+                Event<void(int)> copy(e);
+                g_sink = g_sink + static_cast<int>(copy.GetListenerCount());
+            });
+        }
+    }
+
+    void BenchResults()
+    {
+        for (size_t n : ListenerCounts)
+        {
+            vector<shared_ptr<listener const>> owners;
+            Event<int(int)> e;
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener(owners.emplace_back(make_shared<listener const>()), &listener::Get);
+            vector<int> out(n);
+            Measure("results/list", n, IterationFor(n), [&] { g_sink = g_sink + static_cast<int>(e(1).size()); });
+            Measure("results/invoke_sum", n, IterationFor(n), [&] { g_sink = g_sink + e.Invoke<Combiner::Sum>(1); });
+            Measure("results/invoke_to_span", n, IterationFor(n), [&] { g_sink = g_sink + static_cast<int>(e.InvokeTo(span<int>(out), 1)); });
+        }
+    }
+
+    void BenchBatch()
+    {
+        // 매개변수 묶음 1000개를 묶음마다 operator()로 호출하는 비용과 InvokeBatch로 한 번에 호출하는 비용
+        constexpr size_t nArgSet = 1000;
+        using BatchEvent = Event<void(int, float)>;
+        vector<BatchEvent::ArgsTuple> argSets;
+        vector<int> ids;
+        vector<float> values;
+        for (size_t i = 0; i < nArgSet; ++i)
+        {
+            argSets.emplace_back(static_cast<int>(i), static_cast<float>(i));
+            ids.push_back(static_cast<int>(i));
+            values.push_back(static_cast<float>(i));
+        }
+        for (size_t n : { 1, 10, 100 })
+        {
+            BatchEvent e;
+            float local = 0;
+            for (size_t i = 0; i < n; ++i)
+                e.AddListener([&local](int, float f) { local += f; });
+            size_t nIteration = max<size_t>(1, 1000 / n);
+            Measure("batch/loop", n, nIteration, [&]
+            {
+                for (auto &[id, value] : argSets)
+                    e(id, value);
+            });
+            Measure("batch/aos", n, nIteration, [&] { e.InvokeBatch(argSets); });
+            Measure("batch/soa", n, nIteration, [&] { e.InvokeBatch(ids, values); });
+            g_sink = g_sink + static_cast<int>(local);
+        }
+        {
+            BatchEvent e;
+            float local = 0;
+            e.AddBulkListener([&local](span<int const>, span<float const> values)
+            {
+                for (float f : values)
+                    local += f;
+            });
+            Measure("batch/bulk_soa", 1, 1000, [&] { e.InvokeBatch(ids, values); });
+            g_sink = g_sink + static_cast<int>(local);
+        }
+    }
+
+    void BenchKeyed()
+    {
+        // 엔티티마다 리스너 하나가 자기 ID만 처리할 때 모두 호출해 걸러내는 비용과 키별 이벤트로 찾아가는 비용
+        for (size_t n : ListenerCounts)
+        {
+            Event<void(int, int)> e;
+            KeyedEvent<int, void(int)> keyed;
+            for (size_t i = 0; i < n; ++i)
+            {
+                e.AddListener([id = static_cast<int>(i)](int target, int damage) { if (target == id) g_sink = g_sink + damage; });
+                keyed.AddListener(static_cast<int>(i), [](int damage) { g_sink = g_sink + damage; });
+            }
+            int target = 0;
+            Measure("keyed/broadcast_filter", n, IterationFor(n), [&] { e(target, 1); target = (target + 1) % static_cast<int>(n); });
+            Measure("keyed/hashed", n, IterationFor(n), [&] { keyed(target, 1); target = (target + 1) % static_cast<int>(n); });
+        }
+    }
+
+    void BenchCoalescing()
+    {
+        // 한 프레임에 100번 들어오는 값을 매번 호출하는 비용과 합쳐서 프레임마다 한 번 호출하는 비용
+        constexpr int nFire = 100;
+        for (size_t n : ListenerCounts)
+        {
+            Event<void(int)> e;
+            for (size_t i = 0; i < n; ++i)
+                e += OnEvent;
+            CoalescingEvent<void(int)> coalesced(e);
+            size_t nIteration = max<size_t>(1, IterationFor(n) / nFire);
+            Measure("coalesce/fire_each", n, nIteration, [&]
+            {
+                for (int i = 0; i < nFire; ++i)
+                    e(i);
+            });
+            Measure("coalesce/post_flush", n, nIteration, [&]
+            {
+                for (int i = 0; i < nFire; ++i)
+                    coalesced.Post(i);
+                coalesced.Flush();
+            });
+        }
+    }
+
+    void BenchTrace()
+    {
+        // 기록 중인 이벤트의 호출 비용과 기록된 로그를 매핑해 재생하는 비용
+        char const *path = "ysEventBench.trace";
+        constexpr size_t nFire = 1000000;
+        Event<void(int, float)> e;
+        e += [](int i, float) { g_sink = g_sink + i; };
+        bool const bRecord = IsSelected("trace/fire_recorded") || IsSelected("trace/record");
+        bool const bReplay = IsSelected("trace/replay");
+        if (!bRecord && !bReplay && !IsSelected("trace/fire_unrecorded"))
+            return;
+        TraceRecorder recorder;
+        if (!recorder.Open(path))
+            return;
+        Measure("trace/fire_unrecorded", 1, nFire, [&] { e(1, 0.5f); });
+        recorder.Attach(e, 0);
+        // 측정 사이에 Flush해서 파일에 쓴 청크를 다시 쓰게 한다.
+        auto flush = [&] { recorder.Flush(); };
+        Measure("trace/fire_recorded", 1, nFire, flush, [&] { e(1, 0.5f); });
+        Measure("trace/record", 1, nFire, flush, [&] { recorder.Record(0, 1, 0.5f); });
+        // 재생만 고른 경우에도 재생할 로그가 있도록 측정 없이 기록한다.
+        if (bReplay && !bRecord)
+        {
+            for (size_t i = 0; i < nFire; ++i)
+                recorder.Record(0, 1, 0.5f);
+        }
+        recorder.Close();
+
+        TraceReplayer replayer;
+        if (bReplay && replayer.Open(path))
+        {
+            Event<void(int, float)> target;
+            target += [](int i, float) { g_sink = g_sink + i; };
+            replayer.Bind(0, target);
+            Measure("trace/replay", 1, 1, [&]
+            {
+                auto report = replayer.Replay();
+                g_sink = g_sink + static_cast<int>(report.nRecord);
+            });
+            // 한 번 호출에 레코드 수만큼 호출하므로 레코드 하나당 시간으로 바꾼다.
+            g_results.back().nListener = replayer.GetRecordCount();
+            replayer.Close();
+        }
+        remove(path);
+    }
+
+    void PrintJson()
+    {
+        cout << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < g_results.size(); ++i)
+        {
+            auto const &r = g_results[i];
+            cout << "    { \"name\": \"" << r.name << "\", \"listeners\": " << r.nListener << ", \"iterations\": " << r.nIteration
+                 << ", \"repetitions\": " << Repetitions << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs
+                 << ", \"median_ns_per_listener\": " << r.medianNs / static_cast<double>(r.nListener) << " }"
+                 << (i + 1 < g_results.size() ? ",\n" : "\n");
+        }
+        cout << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        g_pFilter = argv[1];
+
+    BenchDispatch();
+    BenchChurn();
+    BenchExpiredOwners();
+    BenchCopy();
+    BenchResults();
+    BenchBatch();
+    BenchKeyed();
+    BenchCoalescing();
+    BenchTrace();
+    PrintJson();
+}
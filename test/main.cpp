@@ -1,10 +1,44 @@
 ﻿#include <format>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <cstdlib>
+#include <memory_resource>
+#include <coroutine>
+#include <stop_token>
 #include <ysEvent.hpp>
+#include <ysConcurrentEvent.hpp>
+#include <ysEventQueue.hpp>
+#include <ysThreadPool.hpp>
+#include <ysStaticEvent.hpp>
+#include <ysEventBus.hpp>
+#include <ysLocalExecutor.hpp>
+#include <ysKeyedEvent.hpp>
+#include <ysCoalescingEvent.hpp>
+#include <ysEventTrace.hpp>
 
 using namespace std;
 using namespace YS;
 
+// 전역 할당 횟수, 메모리 리소스 테스트에서 전역 할당이 일어나지 않았는지 확인한다.
+atomic<size_t> g_nGlobalAlloc = 0;
+void *operator new(size_t size)
+{
+    ++g_nGlobalAlloc;
+    if (void *p = malloc(size == 0 ? 1 : size))
+        return p;
+    throw bad_alloc();
+}
+void *operator new(size_t size, nothrow_t const &) noexcept
+{
+    ++g_nGlobalAlloc;
+    return malloc(size == 0 ? 1 : size);
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
 class foo
 {
 public:
@@ -16,6 +50,86 @@ public:
     int id;
 };
 
+class tracked_foo : public Trackable
+{
+public:
+    tracked_foo(int id) : id(id) {}
+
+    void Print() { cout << format("tracked_foo's Print()\ntracked_foo's id : {}\n", id); }
+    int Get() const { return id; }
+
+    int id;
+};
+
+struct key_down
+{
+    int key;
+};
+struct mouse_move
+{
+    int x, y;
+};
+void OnKeyDown(key_down const &e) { cout << format("called OnKeyDown(key : {})\n", e.key); }
+
+class counting_resource : public pmr::memory_resource
+{
+public:
+    explicit counting_resource(pmr::memory_resource *pUpstream) : pUpstream(pUpstream) {}
+
+    size_t nAlloc = 0;
+    size_t nDealloc = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t align) override { ++nAlloc; return pUpstream->allocate(bytes, align); }
+    void do_deallocate(void *p, size_t bytes, size_t align) override { ++nDealloc; pUpstream->deallocate(p, bytes, align); }
+    bool do_is_equal(pmr::memory_resource const &o) const noexcept override { return this == &o; }
+
+    pmr::memory_resource *pUpstream;
+};
+
+class copy_counter
+{
+public:
+    copy_counter() = default;
+    copy_counter(copy_counter const &) { ++nCopy; }
+    copy_counter(copy_counter &&) noexcept { ++nMove; }
+
+    static inline int nCopy = 0;
+    static inline int nMove = 0;
+};
+
+// 생성되자마자 실행되고 끝나면 스스로 소멸하는 테스트용 코루틴
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() { return {}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+detached_task WaitNext(Event<void(int, string const &)> &e, int id)
+{
+    auto [i, s] = co_await e.Next();
+    cout << format("coroutine {} resumed : ({}, {})\n", id, i, s);
+}
+detached_task WaitNextFor(Event<void(int, string const &)> &e, LocalExecutor &executor, chrono::milliseconds timeout, stop_token token)
+{
+    auto result = co_await e.Next(executor, timeout, std::move(token));
+    if (result)
+        cout << format("timed wait resumed : ({}, {})\n", get<0>(*result), get<1>(*result));
+    else
+        cout << format("timed wait resumed without value at {}ms\n", chrono::duration_cast<chrono::milliseconds>(executor.Now().time_since_epoch()).count());
+}
+detached_task SumNext(Event<void(int)> &e, int n, int &sum)
+{
+    for (int i = 0; i < n; ++i)
+        sum += get<0>(co_await e.Next());
+}
+
 template <class T>
 T const& GetFoo()
 {
@@ -24,6 +138,8 @@ T const& GetFoo()
 }
 
 void Normal_void_void() { cout << "called Normal_void_void()\n"; }
+void Normal_void_cc(copy_counter) {}
+void Normal_void_ccr(copy_counter const &) {}
 void Normal_void_int(int i) { cout << format("called Normal_void_int(int : {})\n", i); }
 int Normal_int_void() { cout << "called Normal_int_void(), return 7\n"; return 7; }
 int Normal_int_int(int i) { cout << format("called Normal_int_int(int : {}), return {}\n", i, i); return i; }
@@ -216,4 +332,841 @@ int main()
     e1.RemoveListener(pConstFoo, SelectConstFn(&foo::Print));
     cout << "e1()\n";
     e1();
+    cout << "\n\n";
+
+    // 소유 객체 만료 테스트
+    cout << "test expired owner\n\n";
+    Event<void()> e2;
+    auto pTempFoo = make_shared<foo>(77);
+    cout << R"(e2.AddListener(pTempFoo, SelectNonConstFn(&foo::Print)))" << endl;
+    e2.AddListener(pTempFoo, SelectNonConstFn(&foo::Print));
+    cout << R"(e2.AddListener(pFoo, SelectConstFn(&foo::Print)))" << endl;
+    e2.AddListener(pFoo, SelectConstFn(&foo::Print));
+    cout << "e2()\n";
+    e2();
+    cout << "pTempFoo.reset()\n";
+    pTempFoo.reset();
+    cout << "e2()\n";
+    e2();
+    cout << format("e2.Compact() : {}\n", e2.Compact());
+    pTempFoo = make_shared<foo>(78);
+    cout << R"(e2.AddListener(pTempFoo, SelectNonConstFn(&foo::Print)))" << endl;
+    e2.AddListener(pTempFoo, SelectNonConstFn(&foo::Print));
+    cout << "pTempFoo.reset()\n";
+    pTempFoo.reset();
+    cout << format("e2.PruneExpired() : {}\n", e2.PruneExpired());
+    e2.RemoveListener(e2.AddListener(pFoo, SelectConstFn(&foo::Print)));
+    cout << format("e2.PruneExpired() after RemoveListener(handle) : {}\n", e2.PruneExpired());
+    cout << "e2()\n";
+    e2();    cout << "\n\n";
+
+    // ListenerHandle 테스트
+    cout << "test ListenerHandle\n\n";
+    Event<void(int)> e3;
+    cout << R"(auto h1 = e3.AddListener(Normal_void_int))" << endl;
+    auto h1 = e3.AddListener(Normal_void_int);
+    cout << R"(auto h2 = e3.AddListener([](int i) { cout << format("called void(int : {}) lambda\n", i); }))" << endl;
+    auto h2 = e3.AddListener([](int i) { cout << format("called void(int : {}) lambda\n", i); });
+    cout << "e3(1)\n";
+    e3(1);
+    cout << format("e3.RemoveListener(h1) : {}\n", e3.RemoveListener(h1));
+    cout << format("e3.RemoveListener(h1) : {}\n", e3.RemoveListener(h1));
+    cout << "e3(2)\n";
+    e3(2);
+    {
+        cout << R"(ScopedConnection conn(e3, e3.AddListener(Normal_void_int)))" << endl;
+        ScopedConnection conn(e3, e3.AddListener(Normal_void_int));
+        cout << "e3(3)\n";
+        e3(3);
+    }
+    cout << "e3(4)\n";
+    e3(4);
+    cout << format("e3.IsListening(h2) : {}\n", e3.IsListening(h2));    cout << "\n\n";
+
+    // ConcurrentEvent 스트레스 테스트
+    cout << "test ConcurrentEvent\n\n";
+    {
+        constexpr int nProducer = 4, nSubscriber = 4, nFire = 20000, nChurn = 2000;
+        struct counter
+        {
+            void Add(int i) { sum += i; }
+            atomic<long long> sum = 0;
+        };
+        ConcurrentEvent<void(int)> ce;
+        auto pStable = make_shared<counter>();
+        ce.AddListener(pStable, &counter::Add);
+
+        atomic<bool> bStop = false;
+        vector<thread> subscribers;
+        for (int t = 0; t < nSubscriber; ++t)
+        {
+            subscribers.emplace_back([&]()
+            {
+                for (int i = 0; i < nChurn; ++i)
+                {
+                    auto pTemp = make_shared<counter>();
+                    auto handle = ce.AddListener(pTemp, &counter::Add);
+                    if (i % 2 == 0)
+                        ce.RemoveListener(handle);
+                    else
+                        pTemp.reset();
+                    if (i % 64 == 0)
+                        ce.PruneExpired();
+                }
+            });
+        }
+        vector<thread> producers;
+        for (int t = 0; t < nProducer; ++t)
+            producers.emplace_back([&]() { for (int i = 0; i < nFire; ++i) ce(1); });
+        for (auto &t : producers)
+            t.join();
+        for (auto &t : subscribers)
+            t.join();
+        ce.PruneExpired();
+
+        cout << format("stable listener sum : {} (expected {})\n", pStable->sum.load(), nProducer * nFire);
+        cout << format("listener count after churn : {}\n", ce.GetListenerCount());
+    }
+    cout << "\n\n";
+
+    // 결합기 테스트
+    cout << "test Invoke\n\n";
+    Event<int(int)> e4;
+    e4 += [](int i) { return i; };
+    e4 += [](int i) { return i * 3; };
+    e4 += [](int i) { return i * 2; };
+    cout << format("e4.Invoke<Combiner::First>(2) : {}\n", *e4.Invoke<Combiner::First>(2));
+    cout << format("e4.Invoke<Combiner::Last>(2) : {}\n", *e4.Invoke<Combiner::Last>(2));
+    cout << format("e4.Invoke<Combiner::Sum>(2) : {}\n", e4.Invoke<Combiner::Sum>(2));
+    cout << format("e4.Invoke<Combiner::Min>(2) : {}\n", *e4.Invoke<Combiner::Min>(2));
+    cout << format("e4.Invoke<Combiner::Max>(2) : {}\n", *e4.Invoke<Combiner::Max>(2));
+    vector<int> rvs;
+    e4.InvokeTo(back_inserter(rvs), 5);
+    cout << format("e4.InvokeTo(back_inserter(rvs), 5) : {} {} {}\n", rvs[0], rvs[1], rvs[2]);
+    array<int, 2> buffer{};
+    cout << format("e4.InvokeTo(span<int>(buffer), 7) : {}\n", e4.InvokeTo(span<int>(buffer), 7));
+    cout << format("buffer : {} {}\n", buffer[0], buffer[1]);
+    Event<bool(int)> e5;
+    e5 += [](int i) { cout << "called i > 0\n"; return i > 0; };
+    e5 += [](int i) { cout << "called i > 10\n"; return i > 10; };
+    e5 += [](int i) { cout << "called i > 100\n"; return i > 100; };
+    cout << "e5.Invoke<Combiner::And>(5)\n";
+    cout << format("{}\n", e5.Invoke<Combiner::And>(5));
+    cout << "e5.Invoke<Combiner::Or>(50)\n";
+    cout << format("{}\n", e5.Invoke<Combiner::Or>(50));
+    cout << "\n\n";
+
+    // 매개변수 복사 횟수 테스트
+    cout << "test argument copies\n\n";
+    Event<void(copy_counter)> byValue;
+    Event<void(copy_counter const &)> byConstRef;
+    for (int i = 0; i < 3; ++i)
+    {
+        byValue += Normal_void_cc;
+        byConstRef += Normal_void_ccr;
+    }
+    copy_counter cc;
+    copy_counter::nCopy = copy_counter::nMove = 0;
+    byValue(cc);
+    cout << format("byValue(cc) with 3 listeners : copy {}, move {}\n", copy_counter::nCopy, copy_counter::nMove);
+    copy_counter::nCopy = copy_counter::nMove = 0;
+    byConstRef(cc);
+    cout << format("byConstRef(cc) with 3 listeners : copy {}, move {}\n", copy_counter::nCopy, copy_counter::nMove);
+    cout << "\n\n";
+
+    // EventQueue 테스트
+    cout << "test EventQueue\n\n";
+    {
+        Event<void(int, string)> target;
+        target += [](int i, string s) { cout << format("called void(int : {}, string : {}) lambda\n", i, s); };
+        EventQueue<void(int, string)> queue(target, 4, QueueFullPolicy::DropOldest);
+        for (int i = 0; i < 6; ++i)
+        {
+            cout << format(R"(queue.Post({}, "post"))", i) << endl;
+            queue.Post(i, "post");
+        }
+        cout << format("queue.GetDroppedCount() : {}\n", queue.GetDroppedCount());
+        cout << "queue.Flush()\n";
+        cout << format("flushed : {}\n", queue.Flush());
+
+        constexpr int nProducer = 4, nPost = 10000;
+        struct counter
+        {
+            void Add(int i) { sum += i; }
+            atomic<long long> sum = 0;
+        };
+        auto pCounter = make_shared<counter>();
+        Event<void(int)> workerTarget(pCounter, &counter::Add);
+        EventQueue<void(int)> workerQueue(workerTarget, 256, QueueFullPolicy::Block);
+        cout << "workerQueue.StartWorker()\n";
+        workerQueue.StartWorker();
+        vector<thread> producers;
+        for (int t = 0; t < nProducer; ++t)
+            producers.emplace_back([&]() { for (int i = 0; i < nPost; ++i) workerQueue.Post(1); });
+        for (auto &t : producers)
+            t.join();
+        cout << "workerQueue.StopWorker()\n";
+        workerQueue.StopWorker();
+        cout << format("worker sum : {} (expected {})\n", pCounter->sum.load(), nProducer * nPost);
+
+        // 리스너가 자기 큐에 Post하고 Flush해도 교착되지 않아야 한다.
+        Event<void(int)> loopTarget;
+        EventQueue<void(int)> loopQueue(loopTarget, 2, QueueFullPolicy::Block);
+        loopTarget.AddListener([&](int i)
+        {
+            bool bPosted = i < 3 && loopQueue.Post(i + 1);
+            bool bOverflowPosted = i < 3 && loopQueue.Post(i + 10);
+            cout << format("loop listener({}) : Post {}, overflow Post {}, nested Flush() : {}\n", i, bPosted, bOverflowPosted, loopQueue.Flush());
+        });
+        loopQueue.Post(0);
+        size_t nFlushed = loopQueue.Flush();
+        cout << format("flushed : {}, GetDroppedCount() : {}\n", nFlushed, loopQueue.GetDroppedCount());
+        nFlushed = loopQueue.Flush();
+        cout << format("flushed : {}\n", nFlushed);
+    }
+    cout << "\n\n";
+
+    // InvokeParallel 테스트
+    cout << "test InvokeParallel\n\n";
+    {
+        ThreadPool pool(3);
+        struct weight
+        {
+            weight(int w) : w(w) {}
+            int Apply(int i) const { return i * w; }
+            int w;
+        };
+        Event<int(int)> heavy;
+        vector<shared_ptr<weight>> weights;
+        for (int i = 0; i < 100; ++i)
+        {
+            weights.push_back(make_shared<weight>(i));
+            heavy.AddListener(weights.back(), &weight::Apply);
+        }
+        for (int i = 0; i < 100; i += 3)
+            weights[i].reset();
+        auto rvs = heavy.InvokeParallel(pool, 2);
+        bool bOrdered = is_sorted(rvs.begin(), rvs.end());
+        cout << format("heavy.InvokeParallel(pool, 2) : {} results, ordered : {}\n", rvs.size(), bOrdered);
+        cout << format("heavy.GetListenerCount() : {}\n", heavy.GetListenerCount());
+
+        static atomic<int> nCalled = 0;
+        Event<void(int)> throwing;
+        throwing += [](int) { ++nCalled; };
+        throwing += [](int i) { ++nCalled; if (i == 1) throw runtime_error("first listener failed"); };
+        for (int i = 0; i < 20; ++i)
+            throwing += [](int) { ++nCalled; };
+        throwing += [](int i) { ++nCalled; if (i == 1) throw runtime_error("last listener failed"); };
+        try { throwing.InvokeParallel(pool, 1); }
+        catch (runtime_error const &e) { cout << format("throwing.InvokeParallel(pool, 1) threw : {}\n", e.what()); }
+        cout << format("called listeners : {}\n", nCalled.load());
+    }
+    cout << "\n\n";
+
+    // StaticEvent 테스트
+    cout << "test StaticEvent\n\n";
+    {
+        foo staticFoo(9);
+        foo const staticConstFoo(10);
+        cout << R"(StaticEvent<void(), Normal_void_void, SelectNonConstFn(&foo::Print), SelectConstFn(&foo::Print)> se(staticFoo, staticConstFoo))" << endl;
+        StaticEvent<void(), Normal_void_void, SelectNonConstFn(&foo::Print), SelectConstFn(&foo::Print)> se(staticFoo, staticConstFoo);
+        cout << "se()\n";
+        se();
+        StaticEvent<int(int), Normal_int_int, Normal_int_int> sei;
+        cout << "sei(4)\n";
+        auto rvs = sei(4);
+        cout << format("sei(4) : {} {}\n", rvs[0], rvs[1]);
+        cout << format("sei.Invoke<Combiner::Sum>(3) : {}\n", sei.Invoke<Combiner::Sum>(3));
+    }
+    cout << "\n\n";
+
+    // 캡처가 있는 람다 테스트
+    cout << "test capturing lambda\n\n";
+    {
+        Event<int(int)> e6;
+        int base = 100;
+        cout << R"(auto hSmall = e6.AddListener([base](int i) { return base + i; }))" << endl;
+        auto hSmall = e6.AddListener([base](int i) { return base + i; });
+        array<int, 64> table{};
+        table[5] = 55;
+        cout << R"(auto hLarge = e6.AddListener([table](int i) { return table[i]; }))" << endl;
+        auto hLarge = e6.AddListener([table](int i) { return table[i]; });
+        int nCalled = 0;
+        cout << R"(e6.AddListener([&nCalled](int i) { ++nCalled; return i; }))" << endl;
+        e6.AddListener([&nCalled](int i) { ++nCalled; return i; });
+        auto rvs = e6(5);
+        cout << format("e6(5) : {} {} {}, nCalled : {}\n", rvs.front(), *next(rvs.begin()), rvs.back(), nCalled);
+        cout << format("e6.RemoveListener(hSmall) : {}\n", e6.RemoveListener(hSmall));
+        cout << format("e6.RemoveListener(hLarge) : {}\n", e6.RemoveListener(hLarge));
+        auto e6Copy = e6;
+        rvs = e6Copy(7);
+        cout << format("e6Copy(7) : {} results, nCalled : {}\n", rvs.size(), nCalled);
+    }
+    cout << "\n\n";
+
+    // 객체 참조 바인딩 테스트
+    cout << "test raw binding\n\n";
+    {
+        foo rawFoo(11);
+        Event<void()> e7;
+        cout << "auto h = e7.AddListener(rawFoo, SelectNonConstFn(&foo::Print))\n";
+        auto h = e7.AddListener(rawFoo, SelectNonConstFn(&foo::Print));
+        cout << "e7.AddListener(rawFoo, SelectConstFn(&foo::Print))\n";
+        e7.AddListener(rawFoo, SelectConstFn(&foo::Print));
+        cout << "e7()\n";
+        e7();
+        cout << format("e7.RemoveListener(h) : {}\n", e7.RemoveListener(h));
+        cout << "e7.RemoveListener(rawFoo, SelectConstFn(&foo::Print))\n";
+        e7.RemoveListener(rawFoo, SelectConstFn(&foo::Print));
+        cout << format("e7.GetListenerCount() : {}\n", e7.GetListenerCount());
+
+        Event<int()> e8;
+        Event<int()> e8Moved;
+        {
+            tracked_foo trackedFoo(12);
+            cout << "e8.AddListener(trackedFoo, &tracked_foo::Get)\n";
+            e8.AddListener(trackedFoo, &tracked_foo::Get);
+            auto e8Copy = e8;
+            e8Moved = std::move(e8Copy);
+            cout << format("e8().front() : {}, e8Moved().front() : {}\n", e8().front(), e8Moved().front());
+            {
+                Event<int()> e8Temp;
+                e8Temp.AddListener(trackedFoo, &tracked_foo::Get);
+            }
+            cout << "~tracked_foo()\n";
+        }
+        cout << format("e8.GetListenerCount() : {}, e8Moved.GetListenerCount() : {}\n", e8.GetListenerCount(), e8Moved.GetListenerCount());
+
+        ConcurrentEvent<void()> ce2;
+        {
+            tracked_foo trackedFoo(13);
+            cout << "ce2.AddListener(trackedFoo, &tracked_foo::Print)\n";
+            ce2.AddListener(trackedFoo, &tracked_foo::Print);
+            cout << "ce2()\n";
+            ce2();
+            cout << "~tracked_foo()\n";
+        }
+        cout << format("ce2.GetListenerCount() : {}\n", ce2.GetListenerCount());
+    }
+    cout << "\n\n";
+
+    // 계측 정책 테스트
+    cout << "test EventStats\n\n";
+    {
+        cout << "Event<int(), EventStats> e9\n";
+        Event<int(), EventStats> e9;
+        auto pExpiring = make_shared<tracked_foo>(14);
+        e9 += Normal_int_void;
+        e9.AddListener(pExpiring, &tracked_foo::Get);
+        size_t nHooked = 0;
+        e9.GetInstrument().SetListenerHook([](void *pContext, ListenerHandle, chrono::nanoseconds) { ++*static_cast<size_t *>(pContext); }, &nHooked);
+        e9();
+        pExpiring.reset();
+        e9();
+        cout << format("e9.Invoke<Combiner::Sum>() : {}\n", e9.Invoke<Combiner::Sum>());
+        auto const &stats = e9.GetInstrument();
+        uint64_t nHistogram = 0;
+        for (auto n : stats.GetLatencyHistogram())
+            nHistogram += n;
+        cout << format("fire : {}, listener calls : {}, last : {}, pruned : {}, histogram : {}, hooked : {}\n",
+            stats.GetFireCount(), stats.GetListenerCallCount(), stats.GetLastListenerCount(), stats.GetPrunedCount(), nHistogram, nHooked);
+
+        // 스스로 등록 해제하는 리스너도 훅에는 등록할 때 받은 핸들이 전달되어야 한다.
+        Event<void(), EventStats> e9Self;
+        ListenerHandle hSelf9, hHooked;
+        hSelf9 = e9Self.AddListener([&] { e9Self.RemoveListener(hSelf9); });
+        e9Self.GetInstrument().SetListenerHook([](void *pContext, ListenerHandle h, chrono::nanoseconds) { *static_cast<ListenerHandle *>(pContext) = h; }, &hHooked);
+        e9Self();
+        cout << format("self-removing listener hooked with its handle : {}, IsListening : {}\n", hHooked == hSelf9, e9Self.IsListening(hSelf9));
+    }
+    cout << "\n\n";
+
+    // 우선순위, 전파 중단 테스트
+    cout << "test priority\n\n";
+    {
+        Event<void(int)> input;
+        cout << "input.AddListener(Normal_void_int)\n";
+        input.AddListener(Normal_void_int);
+        cout << R"(input.AddListener([](int i) { cout << format("priority 10 : {}\n", i); }, 10))" << endl;
+        input.AddListener([](int i) { cout << format("priority 10 : {}\n", i); }, 10);
+        cout << R"(auto hConsume = input.AddListener([](int i) { cout << format("priority 5 consume : {}\n", i); Propagation::Stop(); }, 5))" << endl;
+        auto hConsume = input.AddListener([](int i) { cout << format("priority 5 consume : {}\n", i); Propagation::Stop(); }, 5);
+        cout << R"(input.AddListener([](int i) { cout << format("priority 10 second : {}\n", i); }, 10))" << endl;
+        input.AddListener([](int i) { cout << format("priority 10 second : {}\n", i); }, 10);
+        cout << "input(1)\n";
+        input(1);
+        input.RemoveListener(hConsume);
+        cout << "input.RemoveListener(hConsume)\ninput(2)\n";
+        input(2);
+
+        Event<bool()> handled;
+        int nCalled = 0;
+        handled.AddListener([&nCalled] { ++nCalled; return false; });
+        handled.AddListener([&nCalled] { ++nCalled; return true; }, 1);
+        handled.AddListener([&nCalled] { ++nCalled; return false; }, -1);
+        cout << format("handled.Invoke<Combiner::Or>() : {}, nCalled : {}\n", handled.Invoke<Combiner::Or>(), nCalled);
+    }
+    cout << "\n\n";
+
+    // EventBus 테스트
+    cout << "test EventBus\n\n";
+    {
+        EventBus bus;
+        cout << "bus.Subscribe<key_down>(OnKeyDown)\n";
+        bus.Subscribe<key_down>(OnKeyDown);
+        cout << R"(auto hMove = bus.Subscribe<mouse_move>([](mouse_move const &e) { cout << format("mouse_move({}, {})\n", e.x, e.y); }))" << endl;
+        auto hMove = bus.Subscribe<mouse_move>([](mouse_move const &e) { cout << format("mouse_move({}, {})\n", e.x, e.y); });
+        cout << "bus.Publish(key_down{ 65 })\n";
+        bus.Publish(key_down{ 65 });
+        cout << "bus.Publish(mouse_move{ 3, 4 })\n";
+        bus.Publish(mouse_move{ 3, 4 });
+        cout << "bus.Publish(1.5f)\n";
+        bus.Publish(1.5f);
+        cout << format("bus.Unsubscribe<mouse_move>(hMove) : {}\n", bus.Unsubscribe<mouse_move>(hMove));
+        bus.Publish(mouse_move{ 5, 6 });
+        size_t channelTotal = 0;
+        auto infos = bus.GetChannelInfos();
+        for (auto const &info : infos)
+            channelTotal += info.memoryUsage;
+        cout << format("channels : {}, key_down listeners : {}, total > channels : {}, key_down usage matches : {}\n",
+            infos.size(), bus.GetListenerCount<key_down>(), bus.MemoryUsage() > channelTotal,
+            bus.MemoryUsage<key_down>() == bus.Find<key_down>()->MemoryUsage());
+    }
+    cout << "\n\n";
+
+    // 복사 시 리스너 저장소 공유 테스트
+    cout << "test copy-on-write\n\n";
+    {
+        Event<void()> e10;
+        auto h = e10.AddListener([cc = copy_counter()] {});
+        auto pExpiring = make_shared<foo>(15);
+        e10.AddListener(pExpiring, SelectConstFn(&foo::Print));
+        int nCopy = copy_counter::nCopy;
+        Event<void()> e10Copy = e10;
+        Event<void()> e10Copy2(e10Copy);
+        cout << format("copies after 2 event copies : {}\n", copy_counter::nCopy - nCopy);
+        pExpiring.reset();
+        thread t([&] { for (int i = 0; i < 1000; ++i) e10(); });
+        for (int i = 0; i < 1000; ++i)
+            e10Copy2();
+        t.join();
+        cout << format("e10Copy.RemoveListener(h) : {}\n", e10Copy.RemoveListener(h));
+        cout << format("copies after first mutation : {}\n", copy_counter::nCopy - nCopy);
+        cout << format("e10.IsListening(h) : {}, e10Copy.IsListening(h) : {}\n", e10.IsListening(h), e10Copy.IsListening(h));
+        cout << format("e10.PruneExpired() : {}, e10.GetListenerCount() : {}, e10Copy2.GetListenerCount() : {}\n", e10.PruneExpired(), e10.GetListenerCount(), e10Copy2.GetListenerCount());
+
+        // 공유 중인 저장소의 RemoveAllListener는 리스너를 복제하지 않고, 기존 핸들은 새 리스너를 가리키지 않는다.
+        Event<void()> e10Copy3 = e10Copy2;
+        nCopy = copy_counter::nCopy;
+        e10Copy3.RemoveAllListener();
+        auto hNew = e10Copy3.AddListener([] {});
+        cout << format("copies in shared RemoveAllListener : {}, e10Copy3.IsListening(h) : {}, e10Copy3.IsListening(hNew) : {}, e10Copy2.GetListenerCount() : {}\n",
+            copy_counter::nCopy - nCopy, e10Copy3.IsListening(h), e10Copy3.IsListening(hNew), e10Copy2.GetListenerCount());
+
+        // 호출 중에 공유 중인 저장소를 비워도 호출 중인 리스너는 살아있고 나머지는 호출되지 않는다.
+        Event<void()> e10Shared, e10SharedCopy;
+        int nSharedCalled = 0;
+        e10Shared.AddListener([&, cc = copy_counter()] { ++nSharedCalled; e10Shared.RemoveAllListener(); e10Shared.AddListener([&] { ++nSharedCalled; }); });
+        e10Shared.AddListener([&] { ++nSharedCalled; });
+        e10SharedCopy = e10Shared;
+        e10Shared();
+        cout << format("shared RemoveAllListener in listener, called : {}, GetListenerCount() : {}, copy : {}\n", nSharedCalled, e10Shared.GetListenerCount(), e10SharedCopy.GetListenerCount());
+    }
+    cout << "\n\n";
+
+    // 메모리 리소스 테스트
+    cout << "test memory resource\n\n";
+    {
+        alignas(max_align_t) array<byte, 16 * 1024> buffer;
+        pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), pmr::null_memory_resource());
+        counting_resource counter(&arena);
+        array<int, 16> big{ 100 };
+        int sum = 0, copySum = 0;
+        size_t nCollected = 0, nWritten = 0;
+        bool bCopyRemoved = false, bStillListening = false;
+        size_t nGlobal = g_nGlobalAlloc;
+        {
+            Event<int(int)> e11(&counter);
+            e11 += [](int i) { return i; };
+            auto h = e11.AddListener([big](int i) { return i + big[0]; });
+            e11.AddListener([&pFoo](int i) { return i + pFoo->id; }, 1);
+            for (int i = 0; i < 100; ++i)
+                sum += e11.Invoke<Combiner::Sum>(1);
+            pmr::vector<int> rvs = e11.Collect(&counter, 2);
+            nCollected = rvs.size();
+            Event<int(int)> e11Copy(e11, &counter);
+            bCopyRemoved = e11Copy.RemoveListener(h);
+            bStillListening = e11.IsListening(h);
+            copySum = e11Copy.Invoke<Combiner::Sum>(1);
+            pmr::vector<int> out(&counter);
+            e11.InvokeTo(back_inserter(out), 3);
+            nWritten = out.size();
+        }
+        size_t nGlobalDiff = g_nGlobalAlloc - nGlobal;
+        cout << format("sum : {}, copySum : {}, collected : {}, written : {}\n", sum, copySum, nCollected, nWritten);
+        cout << format("e11Copy.RemoveListener(h) : {}, e11.IsListening(h) : {}\n", bCopyRemoved, bStillListening);
+        cout << format("global allocations : {}, resource allocations > 0 : {}, all deallocated : {}\n",
+            nGlobalDiff, counter.nAlloc > 0, counter.nAlloc == counter.nDealloc);
+    }
+    cout << "\n\n";
+
+    // 코루틴 대기 테스트
+    cout << "test awaitable\n\n";
+    {
+        Event<void(int, string const &)> e12;
+        e12 += [](int i, string const &s) { cout << format("listener called : ({}, {})\n", i, s); };
+        WaitNext(e12, 1);
+        WaitNext(e12, 2);
+        e12(1, "first");
+        e12(2, "second");
+
+        LocalExecutor executor;
+        WaitNextFor(e12, executor, 10ms, {});
+        executor.AdvanceBy(5ms);
+        e12(3, "before timeout");
+        cout << format("timers after fire : {}\n", executor.GetTimerCount());
+        WaitNextFor(e12, executor, 10ms, {});
+        size_t nExpired = executor.AdvanceBy(20ms);
+        cout << format("expired timers : {}\n", nExpired);
+        stop_source source;
+        WaitNextFor(e12, executor, 10ms, source.get_token());
+        source.request_stop();
+        e12(4, "after cancel");
+        {
+            Event<void(int, string const &)> e14;
+            WaitNextFor(e14, executor, 10ms, {});
+        }
+        executor.AdvanceBy(10ms);
+
+        Event<void(int)> e13;
+        int sum = 0;
+        SumNext(e13, 100, sum);
+        size_t nGlobal = g_nGlobalAlloc;
+        for (int i = 1; i <= 100; ++i)
+            e13(i);
+        size_t nGlobalDiff = g_nGlobalAlloc - nGlobal;
+        cout << format("sum : {}, global allocations during 100 awaits : {}\n", sum, nGlobalDiff);
+    }
+    cout << "\n\n";
+
+    // 호출 중 리스너 변경 테스트
+    cout << "test reentrancy\n\n";
+    {
+        Event<void(int)> e15;
+        ListenerHandle hSelf, hOther, hAdded;
+        hSelf = e15.AddListener([&](int i)
+        {
+            cout << format("self-removing listener : {}\n", i);
+            e15.RemoveListener(hSelf);
+        });
+        e15.AddListener([&](int i)
+        {
+            cout << format("nesting listener : {}\n", i);
+            if (i == 1)
+            {
+                e15(2);
+                hAdded = e15.AddListener([](int i) { cout << format("added listener : {}\n", i); }, 10);
+                cout << format("added during dispatch, IsListening(hAdded) : {}, GetListenerCount() : {}\n", e15.IsListening(hAdded), e15.GetListenerCount());
+            }
+            e15.RemoveListener(hOther);
+        });
+        hOther = e15.AddListener([](int i) { cout << format("other listener : {}\n", i); });
+        e15(1);
+        cout << format("IsListening(hSelf) : {}, IsListening(hOther) : {}, IsListening(hAdded) : {}, GetListenerCount() : {}\n",
+            e15.IsListening(hSelf), e15.IsListening(hOther), e15.IsListening(hAdded), e15.GetListenerCount());
+        e15(3);
+
+        Event<void()> e16;
+        int nCalled = 0;
+        for (int i = 0; i < 3; ++i)
+            e16.AddListener([&] { ++nCalled; e16.RemoveAllListener(); });
+        e16();
+        cout << format("RemoveAllListener in listener, called : {}, GetListenerCount() : {}\n", nCalled, e16.GetListenerCount());
+
+        Event<void()> e17, e17Copy;
+        ListenerHandle hPending;
+        e17.AddListener([&]
+        {
+            if (e17Copy.GetListenerCount() != 0)
+                return;
+            e17Copy = e17;
+            hPending = e17.AddListener([] { cout << "listener removed before added\n"; });
+            e17.AddListener([] { cout << "listener added after copy\n"; });
+            e17.RemoveListener(hPending);
+        });
+        e17 += [] { cout << "second listener of e17\n"; };
+        e17();
+        cout << format("e17.GetListenerCount() : {}, e17Copy.GetListenerCount() : {}\n", e17.GetListenerCount(), e17Copy.GetListenerCount());
+        e17();
+
+        // 호출 중에 리스너 목록의 용량을 넘도록 등록해도 순회 중인 목록은 옮겨지지 않아야 한다.
+        Event<void()> eGrow;
+        int nGrowCalled = 0;
+        bool bGrown = false;
+        eGrow.AddListener([&]
+        {
+            if (std::exchange(bGrown, true))
+                return;
+            for (int i = 0; i < 1000; ++i)
+                eGrow.AddListener([&] { ++nGrowCalled; });
+            eGrow.PruneExpired();
+            eGrow.Compact();
+        });
+        eGrow.AddListener([&] { ++nGrowCalled; }, -1);
+        eGrow();
+        cout << format("grow in listener, called : {}, GetListenerCount() : {}\n", nGrowCalled, eGrow.GetListenerCount());
+        nGrowCalled = 0;
+        eGrow();
+        cout << format("grow in listener, called : {}\n", nGrowCalled);
+
+        // 리스너가 등록하고 전파를 멈춘 뒤 예외를 던져도 바깥 호출은 이어지고 등록은 반영되어야 한다.
+        Event<void()> eThrow, eOuter;
+        bool bThrown = false;
+        eThrow.AddListener([&]
+        {
+            if (std::exchange(bThrown, true))
+                return;
+            eThrow.AddListener([] { cout << "listener added before throw\n"; });
+            Propagation::Stop();
+            throw runtime_error("listener error");
+        });
+        eOuter.AddListener([&]
+        {
+            try { eThrow(); }
+            catch (runtime_error const &e) { cout << format("eThrow() threw : {}\n", e.what()); }
+        });
+        eOuter.AddListener([] { cout << "outer listener after throw\n"; });
+        eOuter();
+        eThrow();
+    }
+    cout << "\n\n";
+
+    // 일괄 호출 테스트
+    cout << "test batch\n\n";
+    {
+        Event<void(int, float)> e18;
+        e18.AddListener([](int i, float f) { cout << format("first({}, {}) ", i, f); });
+        e18.AddListener([](int i, float) { cout << format("second({}) ", i); if (i == 2) Propagation::Stop(); });
+        e18.AddListener([](int i, float) { cout << format("third({}) ", i); });
+        vector<Event<void(int, float)>::ArgsTuple> argSets = { { 1, 0.5f }, { 2, 1.5f }, { 3, 2.5f } };
+        e18.InvokeBatch(argSets);
+        cout << "\n";
+
+        float total = 0;
+        e18.AddBulkListener([&](span<int const> ids, span<float const> values)
+        {
+            cout << format("bulk({}) ", ids.size());
+            for (size_t i = 0; i < ids.size(); ++i)
+                total += values[i];
+        });
+        vector<int> ids = { 4, 5, 6, 7 };
+        vector<float> values = { 1.f, 2.f, 3.f, 4.f, 5.f };
+        e18.InvokeBatch(ids, values);
+        cout << format("\ntotal : {}\n", total);
+        ids = { 1, 2, 3 };
+        e18.InvokeBatch(ids, values);
+        cout << format("\ntotal : {}\n", total);
+        e18(8, 0.25f);
+        cout << format("\ntotal : {}\n", total);
+    }
+    cout << "\n\n";
+
+    // 키별 이벤트 테스트
+    cout << "test keyed event\n\n";
+    {
+        KeyedEvent<int, void(int)> e19;
+        e19.AddListener(1, [](int damage) { cout << format("entity 1 damaged {}\n", damage); });
+        ListenerHandle h2 = e19.AddListener(2, [](int damage) { cout << format("entity 2 damaged {}\n", damage); });
+        e19.AddListener(2, [](int) { cout << "entity 2 high priority\n"; }, 1);
+        ListenerHandle hAll = e19.AddWildcardListener([](int damage) { cout << format("wildcard : {}\n", damage); });
+        e19(1, 10);
+        e19(2, 20);
+        e19(3, 30);
+        e19.RemoveListener(2, h2);
+        e19.RemoveWildcardListener(hAll);
+        e19(2, 40);
+
+        // 키가 많아져 색인이 늘어나고, 키를 지워도 다른 키를 찾을 수 있어야 한다.
+        int nCalled = 0;
+        for (int key = 0; key < 1000; ++key)
+            e19.AddListener(key * 7, [&nCalled](int) { ++nCalled; });
+        for (int key = 0; key < 1000; key += 2)
+            e19.RemoveKey(key * 7);
+        for (int key = 0; key < 1000; ++key)
+            e19(key * 7, 0);
+        cout << format("called : {}, GetKeyCount() : {}, GetListenerCount() : {}\n", nCalled, e19.GetKeyCount(), e19.GetListenerCount());
+        e19.Find(1)->RemoveAllListener();
+        size_t nRemoved = e19.RemoveEmptyKeys();
+        cout << format("RemoveEmptyKeys() : {}, GetKeyCount() : {}, Find(1) : {}\n", nRemoved, e19.GetKeyCount(), e19.Find(1) != nullptr);
+
+        // 리스너 안에서 새 키에 등록해도 호출 중인 버킷은 옮겨지지 않는다.
+        KeyedEvent<string, void()> e20;
+        e20.AddListener("spawn", [&]
+        {
+            for (int i = 0; i < 100; ++i)
+                e20.AddListener(format("child{}", i), [i] { if (i == 99) cout << "child99 called\n"; });
+            cout << "spawn called\n";
+        });
+        e20("spawn");
+        e20("child99");
+
+        struct scaler
+        {
+            int factor;
+            int Apply(int i) const { return factor * i; }
+        };
+        auto pOwner = make_shared<scaler const>(5);
+        KeyedEvent<string, int(int)> e21;
+        e21.AddListener("a", [](int i) { return i; });
+        e21.AddListener("a", pOwner, &scaler::Apply);
+        e21.AddWildcardListener([](int i) { return i * 100; });
+        cout << format("Invoke<Sum>(\"a\", 2) : {}, Invoke<Sum>(\"b\", 2) : {}\n", e21.Invoke<Combiner::Sum>("a", 2), e21.Invoke<Combiner::Sum>("b", 2));
+        // 키 리스너에서 결합기가 중단하면 와일드카드 리스너는 호출되지 않는다.
+        cout << format("Invoke<First>(\"a\", 2) : {}, Invoke<First>(\"b\", 2) : {}\n", *e21.Invoke<Combiner::First>("a", 2), *e21.Invoke<Combiner::First>("b", 2));
+        KeyedEvent<int, bool()> e21Bool;
+        e21Bool.AddListener(1, [] { return true; });
+        e21Bool.AddListener(2, [] { return false; });
+        e21Bool.AddWildcardListener([] { cout << "wildcard called "; return false; });
+        cout << format("Invoke<Or>(1) : {}\n", e21Bool.Invoke<Combiner::Or>(1));
+        cout << format("Invoke<Or>(2) : {}\n", e21Bool.Invoke<Combiner::Or>(2));
+        cout << format("Invoke<And>(1) : {}\n", e21Bool.Invoke<Combiner::And>(1));
+        cout << format("Invoke<And>(2) : {}\n", e21Bool.Invoke<Combiner::And>(2));
+        pOwner.reset();
+        size_t nPruned = e21.PruneExpired();
+        cout << format("PruneExpired() : {}, GetListenerCount(\"a\") : {}\n", nPruned, e21.GetListenerCount("a"));
+    }
+    cout << "\n\n";
+
+    // 합쳐지는 이벤트 테스트
+    cout << "test coalescing event\n\n";
+    {
+        Event<void(int, int)> e22;
+        e22 += [](int w, int h) { cout << format("resized({}, {})\n", w, h); };
+        CoalescingEvent<void(int, int)> resized(e22);
+        for (int i = 1; i <= 5; ++i)
+            resized.Post(i * 100, i * 50);
+        resized.Flush();
+        resized.Flush();
+        cout << format("GetSuppressedCount() : {}, GetDispatchCount() : {}\n", resized.GetSuppressedCount(), resized.GetDispatchCount());
+
+        Event<void(int, string const &)> e23;
+        e23 += [](int delta, string const &path) { cout << format("moved {} : {}\n", delta, path); };
+        CoalescingEvent<void(int, string const &)> moved(e23, [](int &delta, string &path, int newDelta, string const &newPath)
+        {
+            delta += newDelta;
+            path += newPath;
+        });
+        moved.Post(1, "a");
+        moved.Post(2, "b");
+        moved.Post(3, "c");
+        moved.Flush();
+
+        // 최소 호출 간격이 지나지 않은 Flush는 값을 대기시킨 채 넘어간다.
+        resized.SetMinInterval(10ms);
+        LocalExecutor::TimePoint now{};
+        for (int frame = 0; frame < 6; ++frame, now += 4ms)
+        {
+            resized.Post(frame, frame);
+            bool bDispatched = resized.Flush(now);
+            cout << format("frame {} : dispatched {}, HasPending() : {}\n", frame, bDispatched, resized.HasPending());
+        }
+        cout << format("GetSuppressedCount() : {}, GetDispatchCount() : {}\n", resized.GetSuppressedCount(), resized.GetDispatchCount());
+
+        // 리스너 안에서 Post한 값들은 호출 중인 값과 섞이지 않고 새로 합쳐져 다음 Flush에서 한 번 호출된다.
+        Event<void(int)> e22Scroll;
+        CoalescingEvent<void(int)> scrolled(e22Scroll, [](int &delta, int newDelta) { delta += newDelta; });
+        e22Scroll.AddListener([&](int delta)
+        {
+            cout << format("scrolled {}", delta);
+            if (delta < 10)
+            {
+                bool bFirst = scrolled.Post(delta * 10);
+                bool bSecond = scrolled.Post(delta * 20);
+                bool bNested = scrolled.Flush();
+                cout << format(", Post {} {}, nested Flush() : {}", bFirst, bSecond, bNested);
+            }
+            cout << '\n';
+        });
+        scrolled.Post(1);
+        scrolled.Post(2);
+        scrolled.Flush();
+        cout << format("HasPending() : {}\n", scrolled.HasPending());
+        scrolled.Flush();
+        cout << format("HasPending() : {}, GetSuppressedCount() : {}, GetDispatchCount() : {}\n", scrolled.HasPending(), scrolled.GetSuppressedCount(), scrolled.GetDispatchCount());
+    }
+    cout << "\n\n";
+
+    // 트레이스 기록, 재생 테스트
+    cout << "test trace\n\n";
+    {
+        char const *path = "ysEventTest.trace";
+        Event<void(int, float)> e24;
+        Event<void(string const &)> e25;
+        TraceRecorder recorder;
+        cout << format("Open() : {}\n", recorder.Open(path));
+        recorder.Attach(e24, 0);
+        recorder.Attach(e25, 1);
+        e24 += [](int, float) { Propagation::Stop(); };
+        e24(1, 0.5f);
+        e25("hello");
+        // 청크 크기를 넘도록 여러 스레드에서 기록한다.
+        vector<thread> threads;
+        for (int t = 0; t < 3; ++t)
+            threads.emplace_back([&, t] { for (int i = 0; i < 5000; ++i) recorder.Record(0, t, static_cast<float>(i)); });
+        for (auto &th : threads)
+            th.join();
+        e25(string(100000, 'x'));
+        // 한 스레드가 두 기록기에 번갈아 기록해도 각자의 버퍼에 들어가야 한다.
+        {
+            TraceRecorder other;
+            other.Open("ysEventTestOther.trace");
+            for (int i = 0; i < 100; ++i)
+            {
+                recorder.Record(2, i);
+                other.Record(0, i);
+            }
+            other.Close();
+            cout << format("alternating recorders, other.GetRecordCount() : {}\n", other.GetRecordCount());
+            remove("ysEventTestOther.trace");
+        }
+        recorder.Flush();
+        recorder.Close();
+        cout << format("GetRecordCount() : {}\n", recorder.GetRecordCount());
+
+        TraceReplayer replayer;
+        bool bOpened = replayer.Open(path);
+        cout << format("Open() : {}, GetRecordCount() : {}\n", bOpened, replayer.GetRecordCount());
+        Event<void(int, float)> replay24;
+        Event<void(string_view)> replay25;
+        array<double, 4> sums{};
+        replay24.AddListener([&](int t, float f) { sums[t < 0 || t > 2 ? 3 : t] += f; });
+        replay25 += [](string_view s) { cout << format("replayed string of {} : {}\n", s.size(), s.substr(0, 5)); };
+        replayer.Bind(0, replay24);
+        auto report = replayer.Replay();
+        cout << format("nRecord : {}, nSkipped : {}, sums : {} {} {} {}\n", report.nRecord, report.nSkipped, sums[0], sums[1], sums[2], sums[3]);
+        replayer.Bind(1, replay25);
+        report = replayer.Replay(ReplayMode::RecordedSpeed);
+        cout << format("nRecord : {}, fireCounts : {} {}, elapsed >= recordedDuration : {}\n",
+            report.nRecord, report.fireCounts[0], report.fireCounts[1], report.elapsed >= report.recordedDuration);
+        replayer.Close();
+
+        // 기본 생성자가 없는 자명하게 복사 가능한 타입도 기록하고 재생할 수 있어야 한다.
+        struct point
+        {
+            point(int x, int y) : x(x), y(y) {}
+            int x, y;
+        };
+        Event<void(point, vector<point> const &)> e26;
+        recorder.Open(path);
+        recorder.Attach(e26, 0);
+        e26(point(1, 2), { point(3, 4), point(5, 6) });
+        recorder.Close();
+        Event<void(point, vector<point> const &)> replay26;
+        replay26 += [](point p, vector<point> const &points) { cout << format("replayed point ({}, {}), points : {}, last ({}, {})\n", p.x, p.y, points.size(), points.back().x, points.back().y); };
+        replayer.Open(path);
+        replayer.Bind(0, replay26);
+        replayer.Replay();
+        replayer.Close();
+        remove(path);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+/**
+ * @file ysCoalescingEvent.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 여러 번의 호출을 하나로 합쳐 Flush 때 한 번만 호출하는 이벤트
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <concepts>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    /**
+     * @brief 여러 번의 호출을 하나로 합쳐 Flush 때 한 번만 호출하는 이벤트
+     *
+     * 창 크기 변경, 센서 값, 설정 다시 읽기처럼 한 프레임에 여러 번 들어오지만 마지막 상태만 의미 있는 이벤트에 사용한다.\n
+     * Post는 리스너를 호출하지 않고 대기 중인 매개변수 하나에 합치기만 하며, Flush 때 대기 중인 값이 있다면 대상 이벤트를 한 번 호출한다.\n
+     * 따라서 리스너가 하는 일은 Post 횟수가 아니라 Flush 횟수에 비례한다.
+     * - 합치기 함수 없이 생성하면 마지막 값이 이긴다.
+     * - 합치기 함수를 주면 대기 중인 값에 새 값을 합친다. ex) 이동량 누적, 변경된 영역 합집합
+     * - SetMinInterval로 최소 호출 간격을 정하면 간격이 지나지 않은 Flush는 값을 대기시킨 채 넘어간다.
+     *
+     * 대기 중인 값이 이미 있어 합쳐진 Post 수는 GetSuppressedCount로 알 수 있다.\n
+     * Post와 Flush는 여러 스레드에서 동시에 호출할 수 있다. 대상 이벤트는 Flush한 스레드가 호출하며,
+     * 이때 대기 중인 값을 지키는 뮤텍스는 놓고 Flush끼리 직렬화하는 뮤텍스만 잡고 있다.\n
+     * 따라서 리스너 안에서 Post한 값은 새로 대기 중인 값이 되어 다음 Flush에서 호출되고, 리스너 안에서 부른 Flush는 아무 일도 하지 않는다.\n
+     * 호출할 시점에는 반환 값을 받을 호출자가 없으므로 반환 타입이 void인 이벤트만 사용할 수 있다.
+     *
+     * ex) CoalescingEvent<void(int, int)> resized(onResize); resized.Post(w, h); ... resized.Flush();
+     *
+     * @tparam _FuncType 함수의 타입
+     * @tparam _Event 실제로 호출할 이벤트 템플릿
+     */
+    template <typename _FuncType, template <typename...> class _Event = Event>
+    class CoalescingEvent;
+
+    template <typename... _Args, template <typename...> class _Event>
+    class CoalescingEvent<void(_Args...), _Event>
+    {
+        using TargetEvent = _Event<void(_Args...)>;
+        using Payload = std::tuple<std::decay_t<_Args>...>;
+        using ReducerPtr = std::unique_ptr<void, void (*)(void *)>;
+
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+        using Duration = Clock::duration;
+
+        /**
+         * @brief 마지막 값이 이기는 이벤트 생성
+         *
+         * @param event Flush 때 호출할 이벤트, 이 객체보다 오래 살아있어야 한다.
+         */
+        explicit CoalescingEvent(TargetEvent &event) : m_event(event), m_pReducer(nullptr, [](void *) {}) {}
+        /**
+         * @brief 대기 중인 값에 새 값을 합치는 이벤트 생성
+         *
+         * 합치기 함수는 대기 중인 매개변수들의 참조와 새 매개변수들을 차례로 받아 대기 중인 값을 갱신한다.\n
+         * ex) CoalescingEvent<void(int)> moved(onMoved, [](int &pending, int delta) { pending += delta; });
+         *
+         * @param event Flush 때 호출할 이벤트, 이 객체보다 오래 살아있어야 한다.
+         * @param reducer 합치기 함수, Post가 뮤텍스를 잡은 채 호출한다.
+         */
+        template <class _F>
+            requires std::invocable<std::decay_t<_F> &, std::decay_t<_Args> &..., EventArg<_Args>...>
+        CoalescingEvent(TargetEvent &event, _F &&reducer)
+            : m_event(event)
+            , m_pReducer(new std::decay_t<_F>(std::forward<_F>(reducer)), [](void *p) { delete static_cast<std::decay_t<_F> *>(p); })
+            , m_pfnReduce([](void *p, Payload &pending, EventArg<_Args>... args)
+                {
+                    std::apply([&](auto &...pendingArgs) { (*static_cast<std::decay_t<_F> *>(p))(pendingArgs..., std::forward<EventArg<_Args>>(args)...); }, pending);
+                })
+        {}
+/// @cond
+        CoalescingEvent(CoalescingEvent const &) = delete;
+        CoalescingEvent& operator=(CoalescingEvent const &) = delete;
+/// @endcond
+
+        /**
+         * @brief 매개변수를 대기 중인 값에 합친다.
+         *
+         * 리스너는 호출되지 않는다.
+         *
+         * @param args 나중에 호출할 때 사용할 매개변수
+         * @return 새로 대기 중인 값이 되었는지 여부, 이미 대기 중인 값에 합쳐졌다면 false
+         */
+        bool Post(EventArg<_Args>... args)
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_pending)
+            {
+                m_pending.emplace(std::forward<EventArg<_Args>>(args)...);
+                return true;
+            }
+            if (m_pfnReduce != nullptr)
+                m_pfnReduce(m_pReducer.get(), *m_pending, std::forward<EventArg<_Args>>(args)...);
+            else
+                *m_pending = std::forward_as_tuple(std::forward<EventArg<_Args>>(args)...);
+            m_nSuppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        /**
+         * @brief 대기 중인 값이 있고 최소 호출 간격이 지났다면 대상 이벤트를 한 번 호출
+         *
+         * @return 대상 이벤트를 호출했는지 여부
+         */
+        bool Flush() { return Flush(GetMinInterval() == Duration::zero() ? TimePoint() : Clock::now()); }
+        /**
+         * @brief now를 현재 시간으로 보고 Flush
+         *
+         * 게임 루프의 프레임 시간이나 LocalExecutor::Now()처럼 호출자가 가진 시간을 쓸 때 사용한다.\n
+         * 이 객체를 Flush하는 중인 리스너 안에서 호출하면 아무 일도 하지 않고 false를 반환한다.
+         *
+         * @param now 현재 시간
+         * @return 대상 이벤트를 호출했는지 여부
+         */
+        bool Flush(TimePoint now)
+        {
+            if (m_flushing.IsCurrent())
+                return false;
+            // 대상 이벤트 호출 순서가 Flush 순서와 같도록 Flush끼리는 직렬화한다.
+            std::lock_guard flushLock(m_flushMutex);
+            std::optional<Payload> payload;
+            {
+                std::lock_guard lock(m_mutex);
+                if (!m_pending)
+                    return false;
+                Duration minInterval = GetMinInterval();
+                if (minInterval != Duration::zero() && m_bDispatched && now - m_lastDispatch < minInterval)
+                    return false;
+                payload.swap(m_pending);
+                m_lastDispatch = now;
+                m_bDispatched = true;
+            }
+            FlushingThread::Scope scope(m_flushing);
+            std::apply([this](auto &...args) { m_event(args...); }, *payload);
+            m_nDispatched.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        /**
+         * @brief 대기 중인 값을 호출하지 않고 버린다.
+         *
+         * @return 버린 값이 있었는지 여부
+         */
+        bool Discard()
+        {
+            std::lock_guard lock(m_mutex);
+            bool bHadPending = m_pending.has_value();
+            m_pending.reset();
+            return bHadPending;
+        }
+        /**
+         * @brief 대기 중인 값이 있는지 여부
+         */
+        bool HasPending() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_pending.has_value();
+        }
+        /**
+         * @brief 최소 호출 간격 설정, 0이면 Flush할 때마다 호출한다.
+         *
+         * 첫 호출은 간격과 상관없이 일어나고, 그 뒤로는 마지막 호출로부터 interval이 지나야 다음 호출이 일어난다.
+         */
+        void SetMinInterval(Duration interval) { m_minInterval.store(interval, std::memory_order_relaxed); }
+        Duration GetMinInterval() const { return m_minInterval.load(std::memory_order_relaxed); }
+        /**
+         * @brief 대기 중인 값에 합쳐져 따로 호출되지 않은 Post 수
+         */
+        std::size_t GetSuppressedCount() const { return m_nSuppressed.load(std::memory_order_relaxed); }
+        /**
+         * @brief 대상 이벤트를 호출한 횟수
+         */
+        std::size_t GetDispatchCount() const { return m_nDispatched.load(std::memory_order_relaxed); }
+
+    private:
+        TargetEvent &m_event;
+        ReducerPtr m_pReducer;
+        void (*m_pfnReduce)(void *pReducer, Payload &pending, EventArg<_Args>... args) = nullptr;
+        std::optional<Payload> m_pending;
+        std::atomic<Duration> m_minInterval = Duration::zero();
+        TimePoint m_lastDispatch;
+        bool m_bDispatched = false;
+        std::atomic<std::size_t> m_nSuppressed = 0;
+        std::atomic<std::size_t> m_nDispatched = 0;
+        mutable std::mutex m_mutex;
+        std::mutex m_flushMutex;
+        FlushingThread m_flushing;
+    };
+}
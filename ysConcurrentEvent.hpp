@@ -0,0 +1,375 @@
+/**
+ * @file ysConcurrentEvent.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 여러 스레드에서 동시에 호출할 수 있는 이벤트
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    /**
+     * @brief 스레드 안전한 이벤트 클래스
+     * 
+     * 리스너 목록을 변경 불가능한 스냅샷으로 두고 atomic shared_ptr로 공개한다.\n
+     * 호출하는 스레드는 현재 스냅샷을 읽어 순회하기만 하므로 뮤텍스를 잡지 않고,
+     * 등록과 등록 해제는 쓰기 뮤텍스 안에서 스냅샷을 복사해 새 스냅샷을 공개한다(copy-on-write).\n
+     * 호출 도중 등록 해제된 리스너는 이미 읽은 스냅샷에 남아있으므로 해당 호출에서는 불릴 수 있다.
+     * 
+     * 스냅샷은 읽기 전용이므로 소유 객체가 소멸된 리스너는 호출 시 건너뛰기만 하고,
+     * 다음 등록/등록 해제 또는 PruneExpired 때 새 스냅샷에서 빠진다.
+     * 
+     * @tparam _R 반환 타입
+     * @tparam _Args 매개변수 타입
+     */
+    template <typename _R, typename... _Args>
+    class ConcurrentEvent<_R(_Args...)>
+    {
+#pragma region Type Define
+        using BaseEvent = Event<_R(_Args...)>;
+        using EventFnPtr = FnPtr<_R, _Args...>;
+        template <class _C> using EventMemFnPtr = MemFnPtr<_C, _R, _Args...>;
+        template <class _C> using EventConstMemFnPtr = ConstMemFnPtr<_C, _R, _Args...>;
+        using Function = typename BaseEvent::Function;
+        using NonMemFunction = typename BaseEvent::NonMemFunction;
+        template <class _C> using MemFunction = typename BaseEvent::template MemFunction<_C>;
+        template <class _C> using ConstMemFunction = typename BaseEvent::template ConstMemFunction<_C>;
+        template <class _C> using RawMemFunction = typename BaseEvent::template RawMemFunction<_C>;
+        template <class _C> using RawConstMemFunction = typename BaseEvent::template RawConstMemFunction<_C>;
+        using Snapshot = std::vector<Function>;
+#pragma endregion
+    public:
+/// @cond
+        ConcurrentEvent() : m_pSnapshot(std::make_shared<Snapshot>()), m_pLifetime(std::make_shared<void *>(this)) {}
+        ConcurrentEvent(ConcurrentEvent const &) = delete;
+        ~ConcurrentEvent() = default;
+        ConcurrentEvent& operator=(ConcurrentEvent const &) = delete;
+/// @endcond
+
+        /**
+         * @brief 반환값이 존재하는 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 함수의 반환 값
+         */
+        std::list<_R> operator()(EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            std::list<_R> rvs;
+            Dispatch([&](Function &fn, void const *pOwner) { rvs.push_back(fn(pOwner, std::forward<EventArg<_Args>>(args)...)); });
+            return rvs;
+        }
+        /**
+         * @brief 반환값이 존재하지 않는 함수 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         */
+        void operator()(EventArg<_Args>... args) const
+        {
+            Dispatch([&](Function &fn, void const *pOwner) { fn(pOwner, std::forward<EventArg<_Args>>(args)...); });
+        }
+        /**
+         * @brief 이벤트에 함수 등록
+         * 
+         * @param pFn 등록할 함수 포인터
+         * @return ConcurrentEvent& 자기 자신을 반환
+         */
+        ConcurrentEvent& operator+=(EventFnPtr pFn)
+        {
+            AddListener(pFn);
+            return *this;
+        }
+        /**
+         * @brief pFn을 이벤트에서 등록 해제
+         * 
+         * @param pFn 등록 해제할 함수 포인터
+         * @return ConcurrentEvent& 자기 자신을 반환
+         */
+        ConcurrentEvent& operator-=(EventFnPtr pFn)
+        {
+            RemoveListener(pFn);
+            return *this;
+        }
+
+        /**
+         * @brief 일반 함수 등록
+         * 
+         * @param pFn 등록할 함수 포인터
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        ListenerHandle AddListener(EventFnPtr pFn)
+        {
+            if (pFn == nullptr)
+                return {};
+            return Publish(Function(NonMemFunction(pFn)));
+        }
+        /**
+         * @brief 비상수 객체로부터 비상수 멤버 함수 등록
+         * 
+         * @param pOwner 비상수 멤버 함수를 호출할 비상수 객체
+         * @param pMemFn 등록할 비상수 멤버 함수
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <non_constant _C>
+        ListenerHandle AddListener(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn)
+        {
+            if (pMemFn == nullptr)
+                return {};
+            return Publish(Function(MemFunction<_C>(pOwner, pMemFn)));
+        }
+        /**
+         * @brief 객체로부터 상수 멤버 함수 등록
+         * 
+         * @param pOwner 상수 멤버 함수를 호출할 객체
+         * @param pConstMemFn 등록할 상수 멤버 함수
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <class _C>
+        ListenerHandle AddListener(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn)
+        {
+            if (pConstMemFn == nullptr)
+                return {};
+            return Publish(Function(ConstMemFunction<const _C>(pOwner, pConstMemFn)));
+        }
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 참조로 비상수 멤버 함수 등록
+         * 
+         * 호출 시 소유 객체를 잠그지 않으므로 여러 스레드가 같은 객체를 호출해도 공유 제어 블록을 건드리지 않는다.\n
+         * 소유 객체가 소멸되기 전에 등록 해제되어야 하며, Trackable을 상속했다면 소멸 시 자동으로 등록 해제된다.
+         * 
+         * @param owner 비상수 멤버 함수를 호출할 비상수 객체
+         * @param pMemFn 등록할 비상수 멤버 함수
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <non_constant _C>
+        ListenerHandle AddListener(_C &owner, EventMemFnPtr<_C> pMemFn)
+        {
+            if (pMemFn == nullptr)
+                return {};
+            return Publish(Function(RawMemFunction<_C>(owner, pMemFn)));
+        }
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 참조로 상수 멤버 함수 등록
+         * 
+         * @param owner 상수 멤버 함수를 호출할 객체
+         * @param pConstMemFn 등록할 상수 멤버 함수
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pConstMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <class _C>
+        ListenerHandle AddListener(_C const &owner, EventConstMemFnPtr<_C> pConstMemFn)
+        {
+            if (pConstMemFn == nullptr)
+                return {};
+            return Publish(Function(RawConstMemFunction<_C>(owner, pConstMemFn)));
+        }
+        /// @cond
+        template <class _C>
+        ListenerHandle AddListener(_C const &&, EventConstMemFnPtr<_C>) = delete;
+        /// @endcond
+        /**
+         * @brief 람다, 함수 객체 등 호출 가능한 객체 등록
+         * 
+         * 여러 스레드에서 동시에 호출될 수 있으므로 fn은 동시 호출에 안전해야 한다.
+         * 
+         * @param fn 등록할 호출 가능한 객체
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <class _F>
+            requires(!std::convertible_to<_F, EventFnPtr> && std::is_invocable_r_v<_R, std::decay_t<_F> &, EventArg<_Args>...>)
+        ListenerHandle AddListener(_F &&fn)
+        {
+            return Publish(Function(BaseEvent::MakeCallable(std::forward<_F>(fn))));
+        }
+        /**
+         * @brief 핸들로 리스너 등록 해제
+         * 
+         * @param handle AddListener가 반환한 핸들
+         * @return 리스너가 해제되었는지 여부
+         */
+        bool RemoveListener(ListenerHandle handle)
+        {
+            std::lock_guard lock(m_writeMutex);
+            if (handle.index >= m_generations.size() || m_generations[handle.index] != handle.generation)
+                return false;
+            Republish([&](Function const &fn) { return fn.GetSlot() == handle.index; });
+            return true;
+        }
+        /**
+         * @brief 일반 함수 등록 해제
+         * 
+         * @param pFn 등록된 함수
+         */
+        void RemoveListener(EventFnPtr pFn) { RemoveListener(Function(NonMemFunction(pFn))); }
+        /**
+         * @brief 비상수 객체로 등록된 비상수 멤버 함수 등록 해제
+         * 
+         * @param pOwner 등록한 객체
+         * @param pMemFn 등록된 비상수 멤버 함수
+         */
+        template <non_constant _C>
+        void RemoveListener(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn)
+        {
+            RemoveListener(Function(MemFunction<_C>(pOwner, pMemFn)));
+        }
+        /**
+         * @brief 객체로 등록된 상수 멤버 함수 등록 해제
+         * 
+         * @param pOwner 등록한 객체
+         * @param pConstMemFn 등록된 상수 멤버 함수
+         */
+        template <class _C>
+        void RemoveListener(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn)
+        {
+            RemoveListener(Function(ConstMemFunction<const _C>(pOwner, pConstMemFn)));
+        }
+        /**
+         * @brief 객체 참조로 등록된 비상수 멤버 함수 등록 해제
+         * 
+         * @param owner 등록한 객체
+         * @param pMemFn 등록된 비상수 멤버 함수
+         */
+        template <non_constant _C>
+        void RemoveListener(_C &owner, EventMemFnPtr<_C> pMemFn)
+        {
+            RemoveListener(Function(RawMemFunction<_C>(owner, pMemFn)));
+        }
+        /**
+         * @brief 객체 참조로 등록된 상수 멤버 함수 등록 해제
+         * 
+         * @param owner 등록한 객체
+         * @param pConstMemFn 등록된 상수 멤버 함수
+         */
+        template <class _C>
+        void RemoveListener(_C const &owner, EventConstMemFnPtr<_C> pConstMemFn)
+        {
+            RemoveListener(Function(RawConstMemFunction<_C>(owner, pConstMemFn)));
+        }
+        /**
+         * @brief 등록된 모든 함수들 삭제
+         */
+        void RemoveAllListener()
+        {
+            std::lock_guard lock(m_writeMutex);
+            Republish([](Function const &) { return true; });
+        }
+        /**
+         * @brief 소유 객체가 소멸된 리스너들을 제거한 새 스냅샷 공개
+         * 
+         * @return 제거된 리스너 수
+         */
+        std::size_t PruneExpired()
+        {
+            std::lock_guard lock(m_writeMutex);
+            return Republish([](Function const &) { return false; });
+        }
+        /**
+         * @brief 현재 스냅샷에 담긴 리스너 수
+         */
+        std::size_t GetListenerCount() const { return m_pSnapshot.load(std::memory_order_acquire)->size(); }
+
+    private:
+        /**
+         * @brief 현재 스냅샷의 리스너들을 등록 순서대로 호출
+         * 
+         * 스냅샷을 shared_ptr로 붙잡고 있는 동안에는 다른 스레드가 새 스냅샷을 공개해도 순회 중인 스냅샷은 유지된다.
+         * 
+         * @param call 리스너와 잠근 소유 객체를 받아 실제 호출을 수행하는 함수 객체
+         */
+        template <class _Call>
+        void Dispatch(_Call &&call) const
+        {
+            std::shared_ptr<Snapshot> pSnapshot = m_pSnapshot.load(std::memory_order_acquire);
+            for (Function &fn : *pSnapshot)
+            {
+                if (!fn.HasOwner())
+                    call(fn, nullptr);
+                else if (auto pOwner = fn.Lock())
+                    call(fn, pOwner.get());
+            }
+        }
+        /**
+         * @brief 새 리스너를 추가한 스냅샷 공개
+         * 
+         * @return ListenerHandle 추가된 리스너의 핸들
+         */
+        ListenerHandle Publish(Function &&fn)
+        {
+            std::lock_guard lock(m_writeMutex);
+            std::uint32_t slot;
+            if (!m_freeSlots.empty())
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else
+            {
+                slot = static_cast<std::uint32_t>(m_generations.size());
+                m_generations.push_back(0);
+            }
+            fn.SetSlot(slot);
+
+            auto pOld = m_pSnapshot.load(std::memory_order_relaxed);
+            auto pNew = std::make_shared<Snapshot>();
+            pNew->reserve(pOld->size() + 1);
+            for (Function const &listener : *pOld)
+            {
+                if (listener.HasOwner() && listener.IsOwnerExpired())
+                    ReleaseSlot(listener.GetSlot());
+                else
+                    pNew->push_back(listener);
+            }
+            pNew->push_back(std::move(fn));
+            ListenerHandle handle = { slot, m_generations[slot] };
+            if (Trackable const *pTrackable = pNew->back().GetTrackable())
+                pTrackable->Track(m_pLifetime, [](void *pEvent, ListenerHandle h) { static_cast<ConcurrentEvent *>(pEvent)->RemoveListener(h); }, handle);
+            m_pSnapshot.store(std::move(pNew), std::memory_order_release);
+            return handle;
+        }
+        /**
+         * @brief pred를 만족하거나 소유 객체가 소멸된 리스너를 뺀 스냅샷 공개
+         * 
+         * m_writeMutex를 잡은 상태에서 호출해야 한다.
+         * 
+         * @return 제거된 리스너 수
+         */
+        template <class _Pred>
+        std::size_t Republish(_Pred &&pred)
+        {
+            auto pOld = m_pSnapshot.load(std::memory_order_relaxed);
+            auto pNew = std::make_shared<Snapshot>();
+            pNew->reserve(pOld->size());
+            for (Function const &listener : *pOld)
+            {
+                if (pred(listener) || (listener.HasOwner() && listener.IsOwnerExpired()))
+                    ReleaseSlot(listener.GetSlot());
+                else
+                    pNew->push_back(listener);
+            }
+            std::size_t nErased = pOld->size() - pNew->size();
+            m_pSnapshot.store(std::move(pNew), std::memory_order_release);
+            return nErased;
+        }
+        void RemoveListener(Function const &fn)
+        {
+            std::lock_guard lock(m_writeMutex);
+            bool bFound = false;
+            Republish([&](Function const &listener) { return !bFound && (bFound = listener == fn); });
+        }
+        void ReleaseSlot(std::uint32_t slot)
+        {
+            ++m_generations[slot];
+            m_freeSlots.push_back(slot);
+        }
+
+        std::atomic<std::shared_ptr<Snapshot>> m_pSnapshot;
+        std::mutex m_writeMutex;
+        std::vector<std::uint32_t> m_generations;
+        std::vector<std::uint32_t> m_freeSlots;
+        std::shared_ptr<void *> m_pLifetime;
+    };
+}
@@ -11,9 +11,29 @@
 
 #pragma once
 #include <list>
+#include <vector>
+#include <array>
+#include <optional>
+#include <span>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <atomic>
 #include <exception>
 #include <concepts>
+#include <chrono>
+#include <bit>
+#include <tuple>
+#include <coroutine>
+#include <stop_token>
 #include <ysDefine.hpp>
 
 namespace YS
@@ -51,7 +71,7 @@ namespace YS
      * @param fp 선택할 멤버 함수 포인터
      * @return MemFnPtr<_C, _R, _Args...> 비상수 멤버 함수 포인터를 반환한다.
      */
-    template <class _C, typename _R, typename... _Args> MemFnPtr<_C, _R, _Args...> SelectNonConstFn(MemFnPtr<_C, _R, _Args...> fp) { return fp; }
+    template <class _C, typename _R, typename... _Args> constexpr MemFnPtr<_C, _R, _Args...> SelectNonConstFn(MemFnPtr<_C, _R, _Args...> fp) { return fp; }
     /**
      * @brief 상수 맴버 함수 포인터를 선택하는 함수
      * 
@@ -60,7 +80,189 @@ namespace YS
      * @param fp 선택할 멤버 함수 포인터
      * @return MemFnPtr<_C, _R, _Args...> 상수 멤버 함수 포인터를 반환한다.
      */
-    template <class _C, typename _R, typename... _Args> ConstMemFnPtr<_C, _R, _Args...> SelectConstFn(ConstMemFnPtr<_C, _R, _Args...> fp) { return fp; }
+    template <class _C, typename _R, typename... _Args> constexpr ConstMemFnPtr<_C, _R, _Args...> SelectConstFn(ConstMemFnPtr<_C, _R, _Args...> fp) { return fp; }
+    /**
+     * @brief 이벤트 호출부터 각 리스너까지 매개변수를 전달할 때 사용하는 타입
+     * 
+     * 값 타입 매개변수는 상수 참조로, 참조 타입 매개변수는 그대로 전달한다.\n
+     * 따라서 값 타입 매개변수는 리스너 자신의 매개변수를 만들 때 한 번만 복사되고,
+     * 상수 참조를 받는 리스너에게는 복사 없이 전달된다.
+     * 
+     * @tparam _T 이벤트 매개변수 타입
+     */
+    template <typename _T> using EventArg = std::conditional_t<std::is_reference_v<_T>, _T, _T const &>;
+
+    /**
+     * @brief 이벤트에 등록된 리스너를 가리키는 핸들
+     * 
+     * 이벤트 내부 슬롯 인덱스와 세대 번호로 이루어져 있어 등록 해제 시 리스너를 찾기 위해 순회하거나 비교할 필요가 없다.\n
+     * 리스너가 해제되면 슬롯의 세대 번호가 바뀌므로 이미 해제된 핸들로 다시 해제해도 아무 일도 일어나지 않는다.
+     */
+    struct ListenerHandle
+    {
+        static constexpr std::uint32_t InvalidIndex = UINT32_MAX;
+
+        bool IsValid() const { return index != InvalidIndex; }
+        bool operator==(ListenerHandle const &) const = default;
+
+        std::uint32_t index = InvalidIndex;
+        std::uint32_t generation = 0;
+    };
+    /**
+     * @brief 소멸 시 리스너를 자동으로 등록 해제하는 RAII 연결 객체
+     * 
+     * RemoveListener(ListenerHandle)을 제공하는 이벤트라면 어떤 타입이든 담을 수 있다.\n
+     * 연결 객체보다 이벤트가 먼저 소멸되거나 이동되면 안된다.
+     */
+    class ScopedConnection
+    {
+    public:
+        ScopedConnection() = default;
+        template <class _Event>
+        ScopedConnection(_Event &event, ListenerHandle handle)
+            : m_pEvent(&event), m_pfnRemove([](void *pEvent, ListenerHandle h) { static_cast<_Event *>(pEvent)->RemoveListener(h); }), m_handle(handle) {}
+        ScopedConnection(ScopedConnection const &) = delete;
+        ScopedConnection(ScopedConnection &&o) noexcept : m_pEvent(o.m_pEvent), m_pfnRemove(o.m_pfnRemove), m_handle(o.Release()) {}
+        ~ScopedConnection() { Disconnect(); }
+        ScopedConnection& operator=(ScopedConnection const &) = delete;
+        ScopedConnection& operator=(ScopedConnection &&o) noexcept
+        {
+            if (this != &o)
+            {
+                Disconnect();
+                m_pEvent = o.m_pEvent;
+                m_pfnRemove = o.m_pfnRemove;
+                m_handle = o.Release();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief 연결된 리스너를 등록 해제
+         */
+        void Disconnect()
+        {
+            if (m_handle.IsValid())
+                m_pfnRemove(m_pEvent, Release());
+        }
+        /**
+         * @brief 등록 해제하지 않고 연결 관리를 포기
+         * 
+         * @return ListenerHandle 관리하던 핸들
+         */
+        ListenerHandle Release() { return std::exchange(m_handle, ListenerHandle()); }
+        bool IsConnected() const { return m_handle.IsValid(); }
+
+    private:
+        void *m_pEvent = nullptr;
+        void (*m_pfnRemove)(void *pEvent, ListenerHandle handle) = nullptr;
+        ListenerHandle m_handle;
+    };
+
+    /**
+     * @brief 계측을 하지 않는 기본 계측 정책
+     * 
+     * Enabled가 false인 정책은 이벤트가 아무 함수도 호출하지 않고 크기도 차지하지 않으므로 비용이 전혀 없다.
+     */
+    struct NullInstrument
+    {
+        static constexpr bool Enabled = false;
+    };
+    /**
+     * @brief 이벤트별 호출 통계를 기록하는 계측 정책
+     * 
+     * 호출 횟수, 호출된 리스너 수, 소유 객체가 소멸되어 정리된 리스너 수, 호출 지연 시간 히스토그램을 기록한다.\n
+     * 리스너별 훅을 설정하면 리스너 하나를 호출할 때마다 걸린 시간을 핸들과 함께 전달받아 외부 트레이서로 보낼 수 있다.\n
+     * 이벤트와 마찬가지로 스레드 안전하지 않으며, InvokeParallel에서는 리스너별 훅만 작업 스레드에서 동시에 호출된다.
+     * 
+     * ex) Event<void(int), EventStats> e; e.GetInstrument().GetFireCount();
+     */
+    class EventStats
+    {
+    public:
+        static constexpr bool Enabled = true;
+        /**
+         * @brief 지연 시간 히스토그램 구간 수
+         * 
+         * i번째 구간은 [2^(i-1), 2^i) 나노초 동안 걸린 호출 수를 센다. 0번째 구간은 1나노초 미만, 마지막 구간은 그 이상 전부이다.
+         */
+        static constexpr std::size_t LatencyBucketCount = 32;
+        using Clock = std::chrono::steady_clock;
+        using LatencyHistogram = std::array<std::uint64_t, LatencyBucketCount>;
+        /**
+         * @brief 리스너별 훅 함수 타입
+         * 
+         * @param pContext SetListenerHook에 넘긴 사용자 데이터
+         * @param handle 호출된 리스너의 핸들
+         * @param elapsed 리스너 호출에 걸린 시간
+         */
+        using ListenerHook = void (*)(void *pContext, ListenerHandle handle, std::chrono::nanoseconds elapsed);
+
+        std::uint64_t GetFireCount() const { return m_nFire; }
+        /**
+         * @brief 지금까지 모든 호출에서 불린 리스너 수의 합
+         */
+        std::uint64_t GetListenerCallCount() const { return m_nListenerCall; }
+        /**
+         * @brief 마지막 호출에서 불린 리스너 수
+         */
+        std::size_t GetLastListenerCount() const { return m_nLastListener; }
+        /**
+         * @brief 소유 객체가 소멸되어 정리된 리스너 수
+         */
+        std::uint64_t GetPrunedCount() const { return m_nPruned; }
+        LatencyHistogram const &GetLatencyHistogram() const { return m_latency; }
+        /**
+         * @brief 리스너별 훅 설정
+         * 
+         * @param pfnHook 리스너 호출마다 불릴 함수, nullptr라면 리스너별 시간을 재지 않는다.
+         * @param pContext pfnHook에 그대로 전달될 사용자 데이터
+         */
+        void SetListenerHook(ListenerHook pfnHook, void *pContext = nullptr)
+        {
+            m_pfnHook = pfnHook;
+            m_pHookContext = pContext;
+        }
+        /**
+         * @brief 리스너별 훅을 제외한 모든 통계 초기화
+         */
+        void Reset()
+        {
+            m_nFire = 0;
+            m_nListenerCall = 0;
+            m_nLastListener = 0;
+            m_nPruned = 0;
+            m_latency = {};
+        }
+
+/// @cond
+        Clock::time_point BeginDispatch() const { return Clock::now(); }
+        void EndDispatch(Clock::time_point begin, std::size_t nListener)
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+            ++m_nFire;
+            m_nListenerCall += nListener;
+            m_nLastListener = nListener;
+            ++m_latency[std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(elapsed)), LatencyBucketCount - 1)];
+        }
+        void OnPrune(std::size_t nPruned) { m_nPruned += nPruned; }
+        bool IsListenerHooked() const { return m_pfnHook != nullptr; }
+        Clock::time_point BeginListener() const { return Clock::now(); }
+        void EndListener(Clock::time_point begin, ListenerHandle handle) const
+        {
+            m_pfnHook(m_pHookContext, handle, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin));
+        }
+/// @endcond
+
+    private:
+        std::uint64_t m_nFire = 0;
+        std::uint64_t m_nListenerCall = 0;
+        std::size_t m_nLastListener = 0;
+        std::uint64_t m_nPruned = 0;
+        LatencyHistogram m_latency = {};
+        ListenerHook m_pfnHook = nullptr;
+        void *m_pHookContext = nullptr;
+    };
 
     /**
      * @brief 기반 이벤트 클래스
@@ -69,312 +271,2072 @@ namespace YS
      * 함수타입 하나로도 간편하게 사용할 수 있도록 하기 위한 전방선언 클래스이다.
      * 
      * @tparam _FuncType 함수의 타입
+     * @tparam _Instrument 호출 계측 정책, 기본값인 NullInstrument는 비용이 없다. 통계가 필요하면 EventStats를 사용한다.
      */
-    template <typename _FuncType>
+    template <typename _FuncType, class _Instrument = NullInstrument>
     class Event;
+    template <typename _FuncType>
+    class ConcurrentEvent;
+
+    /**
+     * @brief 소멸 시 자신에게 바인딩된 리스너들을 자동으로 등록 해제하는 기반 클래스
+     * 
+     * 객체 참조로 바인딩한 리스너(Event::AddListener(_C &, ...))는 호출 시 소유 객체를 잠그지 않으므로
+     * 소유 객체가 소멸되기 전에 등록 해제되어야 한다.\n
+     * 소유 객체가 Trackable을 상속하면 바인딩될 때마다 연결이 기록되고, 소멸자에서 연결된 이벤트들로부터 모두 등록 해제된다.\n
+     * 이벤트가 먼저 소멸되었다면 해당 연결은 건너뛴다. 다만 이벤트의 소멸과 Trackable의 소멸이 서로 다른 스레드에서 동시에 일어나면 안된다.\n
+     * ConcurrentEvent는 등록 해제 전에 읽은 스냅샷으로 호출 중일 수 있으므로, 다른 스레드에서 호출 중인 동안 소유 객체를 소멸시키면 안된다.
+     */
+    class Trackable
+    {
+        template <typename, class> friend class Event;
+        template <typename> friend class ConcurrentEvent;
+    public:
+/// @cond
+        Trackable() = default;
+        Trackable(Trackable const &) noexcept {}
+        ~Trackable() { DisconnectAll(); }
+        Trackable& operator=(Trackable const &) noexcept { return *this; }
+/// @endcond
+
+        /**
+         * @brief 이 객체에 바인딩된 모든 리스너를 등록 해제
+         */
+        void DisconnectAll()
+        {
+            std::vector<Connection> connections;
+            {
+                std::lock_guard lock(m_mutex);
+                connections.swap(m_connections);
+            }
+            for (auto &connection : connections)
+                if (auto pEvent = connection.pEvent.lock())
+                    connection.pfnRemove(*pEvent, connection.handle);
+        }
+
+    private:
+        /**
+         * @brief 이벤트에 바인딩된 리스너를 기록
+         * 
+         * 이미 소멸된 이벤트의 연결은 이때 함께 정리한다.
+         * 
+         * @param pEvent 이벤트의 현재 주소를 담은 수명 토큰
+         * @param pfnRemove 이벤트에서 핸들로 등록 해제하는 함수
+         * @param handle 등록된 리스너의 핸들
+         */
+        void Track(std::weak_ptr<void *> pEvent, void (*pfnRemove)(void *pEvent, ListenerHandle handle), ListenerHandle handle) const
+        {
+            std::lock_guard lock(m_mutex);
+            std::erase_if(m_connections, [](Connection const &connection) { return connection.pEvent.expired(); });
+            m_connections.push_back({ std::move(pEvent), pfnRemove, handle });
+        }
+
+        struct Connection
+        {
+            std::weak_ptr<void *> pEvent;
+            void (*pfnRemove)(void *pEvent, ListenerHandle handle);
+            ListenerHandle handle;
+        };
+        mutable std::mutex m_mutex;
+        mutable std::vector<Connection> m_connections;
+    };
+
+    /**
+     * @brief 이벤트 전파 제어
+     * 
+     * 리스너 안에서 Propagation::Stop()을 호출하면 현재 스레드에서 호출 중인 이벤트의 나머지 리스너들은 호출되지 않는다.\n
+     * 이벤트 객체에 접근할 수 없는 일반 함수 리스너에서도 사용할 수 있도록 스레드별 플래그로 관리한다.\n
+     * 중첩된 이벤트 호출은 각자의 전파 상태를 가지며, InvokeParallel에서는 무시된다.\n
+     * 반환 타입이 bool인 이벤트라면 Invoke<Combiner::Or>로 true를 반환하는 리스너에서 멈추게 할 수도 있다.
+     */
+    class Propagation
+    {
+        template <typename, class> friend class Event;
+    public:
+        /**
+         * @brief 현재 호출 중인 이벤트의 나머지 리스너 호출을 멈춘다.
+         */
+        static void Stop() { s_bStopped = true; }
+
+    private:
+        static inline thread_local bool s_bStopped = false;
+    };
+
+    /**
+     * @brief 이벤트를 모아 두었다가 Flush하는 클래스들이 Flush 중인 스레드를 기록하는 객체
+     * 
+     * Flush는 직렬화용 뮤텍스를 잡은 채 리스너를 호출하므로, 리스너 안에서 같은 객체를 Flush하면 교착된다.\n
+     * Flush 앞에서 IsCurrent()로 확인하고, 리스너를 호출하는 동안 Scope를 두어 기록한다.
+     */
+    class FlushingThread
+    {
+    public:
+        /**
+         * @brief 생성될 때 호출한 스레드를 기록하고 소멸될 때 지우는 객체, 리스너가 예외를 던져도 지워진다.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(FlushingThread &flushing) : m_flushing(flushing) { m_flushing.m_id.store(std::this_thread::get_id(), std::memory_order_relaxed); }
+            Scope(Scope const &) = delete;
+            ~Scope() { m_flushing.m_id.store(std::thread::id(), std::memory_order_relaxed); }
+            Scope& operator=(Scope const &) = delete;
+
+        private:
+            FlushingThread &m_flushing;
+        };
+
+        /**
+         * @brief 호출한 스레드가 Flush하는 중인지 여부
+         * 
+         * 자기 스레드가 쓴 값만 자기 ID와 같을 수 있으므로 relaxed로 충분하다.
+         */
+        bool IsCurrent() const { return m_id.load(std::memory_order_relaxed) == std::this_thread::get_id(); }
+
+    private:
+        std::atomic<std::thread::id> m_id;
+    };
+
+    /**
+     * @brief 리스너들의 반환 값을 하나로 합치는 결합기 컨셉
+     * 
+     * 결합기는 리스너의 반환 값을 하나씩 받아 누적하고, false를 반환하면 나머지 리스너는 호출되지 않는다.\n
+     * 모든 호출이 끝나면 GetResult()로 최종 결과를 꺼낸다.
+     * 
+     * @tparam _Combiner 결합기 타입
+     * @tparam _T 리스너의 반환 타입
+     */
+    template <class _Combiner, typename _T>
+    concept result_combiner = requires(_Combiner &combiner, _T &&value)
+    {
+        { combiner(std::move(value)) } -> std::convertible_to<bool>;
+        combiner.GetResult();
+    };
+    /**
+     * @brief Event::Invoke에 사용할 기본 결합기들
+     * 
+     * 모든 결합기는 힙 할당 없이 결과를 누적한다.
+     */
+    namespace Combiner
+    {
+        /**
+         * @brief 첫 번째 리스너의 반환 값만 취하고 나머지 리스너는 호출하지 않는다.
+         */
+        template <typename _T>
+        class First
+        {
+        public:
+            bool operator()(_T &&value) { m_result.emplace(std::move(value)); return false; }
+            std::optional<_T> GetResult() { return std::move(m_result); }
+        private:
+            std::optional<_T> m_result;
+        };
+        /**
+         * @brief 마지막 리스너의 반환 값을 취한다.
+         */
+        template <typename _T>
+        class Last
+        {
+        public:
+            bool operator()(_T &&value) { m_result.emplace(std::move(value)); return true; }
+            std::optional<_T> GetResult() { return std::move(m_result); }
+        private:
+            std::optional<_T> m_result;
+        };
+        /**
+         * @brief 모든 반환 값이 참인지 확인하며, 거짓이 나오면 나머지 리스너는 호출하지 않는다.
+         * 
+         * 리스너가 없다면 true
+         */
+        template <typename _T>
+        class And
+        {
+        public:
+            bool operator()(_T &&value) { return m_result = static_cast<bool>(value); }
+            bool GetResult() const { return m_result; }
+        private:
+            bool m_result = true;
+        };
+        /**
+         * @brief 반환 값 중 참이 있는지 확인하며, 참이 나오면 나머지 리스너는 호출하지 않는다.
+         * 
+         * 리스너가 없다면 false
+         */
+        template <typename _T>
+        class Or
+        {
+        public:
+            bool operator()(_T &&value) { return !(m_result = static_cast<bool>(value)); }
+            bool GetResult() const { return m_result; }
+        private:
+            bool m_result = false;
+        };
+        /**
+         * @brief 반환 값들의 합, 리스너가 없다면 _T{}
+         */
+        template <typename _T>
+        class Sum
+        {
+        public:
+            bool operator()(_T &&value) { m_result += std::move(value); return true; }
+            _T GetResult() { return std::move(m_result); }
+        private:
+            _T m_result{};
+        };
+        /**
+         * @brief 반환 값들 중 가장 작은 값
+         */
+        template <typename _T>
+        class Min
+        {
+        public:
+            bool operator()(_T &&value)
+            {
+                if (!m_result || value < *m_result)
+                    m_result.emplace(std::move(value));
+                return true;
+            }
+            std::optional<_T> GetResult() { return std::move(m_result); }
+        private:
+            std::optional<_T> m_result;
+        };
+        /**
+         * @brief 반환 값들 중 가장 큰 값
+         */
+        template <typename _T>
+        class Max
+        {
+        public:
+            bool operator()(_T &&value)
+            {
+                if (!m_result || *m_result < value)
+                    m_result.emplace(std::move(value));
+                return true;
+            }
+            std::optional<_T> GetResult() { return std::move(m_result); }
+        private:
+            std::optional<_T> m_result;
+        };
+    }
 
     /**
      * @brief 이벤트 클래스
      * 
-     * 반환 타입과 매개변수 타입을 가진 이벤트 클래스
+     * 반환 타입과 매개변수 타입을 가진 이벤트 클래스\n
+     * 리스너 안에서 같은 이벤트를 다시 호출하거나 리스너를 등록, 해제해도 안전하다.
+     * - 호출 중에 해제된 리스너는 남은 호출(중첩 호출 포함)에서 바로 제외되고, 레코드는 가장 바깥 호출이 끝날 때 한 번에 정리된다.
+     * - 호출 중에 등록된 리스너는 핸들은 바로 받지만 추가 대기 목록에 들어가 가장 바깥 호출이 끝날 때 한 번에 추가되므로 진행 중인 호출에서는 불리지 않는다.
+     * - 호출할 때마다 리스너 목록을 복사하지 않으며, 호출 깊이를 세는 비용만 든다.
      * 
      * @tparam _R 반환 타입
      * @tparam _Args 매개변수 타입
+     * @tparam _Instrument 호출 계측 정책
      */
-    template <typename _R, typename... _Args>
-    class Event<_R(_Args...)>
+    template <typename _R, typename... _Args, class _Instrument>
+    class Event<_R(_Args...), _Instrument>
     {
+        template <typename> friend class ConcurrentEvent;
 #pragma region Type Define
         using EventFnPtr = FnPtr<_R, _Args...>;
         template <class _C> using EventMemFnPtr = MemFnPtr<_C, _R, _Args...>;
         template <class _C> using EventConstMemFnPtr = ConstMemFnPtr<_C, _R, _Args...>;
+        template <class _T> using ArgColumn = std::span<std::remove_cvref_t<_T> const>;
 #pragma endregion
 #pragma region Define Function
         /**
-         * @brief 이벤트에 등록될 함수를 담기 위한 기본 클래스
+         * @brief 함수 객체 저장 공간에 들어갈 수 있는 가장 큰 멤버 함수 포인터 크기를 구하기 위한 불완전 클래스
+         */
+        class UnknownClass;
+        /**
+         * @brief 리스너 레코드에 함수 객체를 직접 담을 수 있는 저장 공간 크기
+         * 
+         * 멤버 함수 바인딩(weak_ptr + 멤버 함수 포인터)이 힙 할당 없이 들어갈 수 있는 크기로 잡는다.
+         */
+        static constexpr std::size_t FunctionStorageSize = sizeof(std::weak_ptr<UnknownClass>) + sizeof(MemFnPtr<UnknownClass, void>);
+        /**
+         * @brief 비멤버 함수를 담기 위한 클래스
+         */
+        class NonMemFunction
+        {
+        public:
+            NonMemFunction(EventFnPtr pFn) : m_pFn(pFn) {}
+            _R operator()(void const *, EventArg<_Args>... args) { return m_pFn(std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(NonMemFunction const &rhs) const { return rhs.m_pFn == m_pFn; }
+        private:
+            EventFnPtr m_pFn;
+        };
+        /**
+         * @brief 비상수 멤버 함수를 담기 위한 클래스
+         * 
+         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         */
+        template <class _C>
+        class MemFunction
+        {
+        public:
+            MemFunction(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn) : m_pOwner(pOwner), m_pMemFn(pMemFn) {}
+            std::shared_ptr<void const> Lock() const { return m_pOwner.lock(); }
+            bool IsOwnerExpired() const { return m_pOwner.expired(); }
+            _R operator()(void const *pOwner, EventArg<_Args>... args) { return (const_cast<_C *>(static_cast<_C const *>(pOwner))->*m_pMemFn)(std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(MemFunction const &rhs) const
+            { return rhs.m_pMemFn == m_pMemFn && !m_pOwner.owner_before(rhs.m_pOwner) && !rhs.m_pOwner.owner_before(m_pOwner); }
+
+        private:
+            std::weak_ptr<_C> m_pOwner;
+            EventMemFnPtr<_C> m_pMemFn;
+        };
+        /**
+         * @brief 상수 멤버 함수를 담기 위한 클래스
+         * 
+         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         */
+        template <constant _C>
+        class ConstMemFunction
+        {
+        public:
+            ConstMemFunction(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn) : m_pOwner(pOwner), m_pConstMemFn(pConstMemFn) {}
+            std::shared_ptr<void const> Lock() const { return m_pOwner.lock(); }
+            bool IsOwnerExpired() const { return m_pOwner.expired(); }
+            _R operator()(void const *pOwner, EventArg<_Args>... args) { return (static_cast<_C *>(pOwner)->*m_pConstMemFn)(std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(ConstMemFunction const &rhs) const
+            { return rhs.m_pConstMemFn == m_pConstMemFn && !m_pOwner.owner_before(rhs.m_pOwner) && !rhs.m_pOwner.owner_before(m_pOwner); }
+
+        private:
+            std::weak_ptr<_C> m_pOwner;
+            EventConstMemFnPtr<std::remove_const_t<_C>> m_pConstMemFn;
+        };
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 주소로 비상수 멤버 함수를 담기 위한 클래스
+         * 
+         * 호출 시 소유 객체를 잠그지 않으므로 원자적 연산 없이 멤버 함수를 바로 호출한다.\n
+         * 소유 객체가 Trackable을 상속했다면 이벤트가 연결을 기록해 소유 객체 소멸 시 등록 해제된다.
+         * 
+         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         */
+        template <class _C>
+        class RawMemFunction
+        {
+        public:
+            RawMemFunction(_C &owner, EventMemFnPtr<_C> pMemFn) : m_pOwner(&owner), m_pMemFn(pMemFn) {}
+            Trackable const *GetTrackable() const
+            {
+                if constexpr (std::derived_from<_C, Trackable>)
+                    return m_pOwner;
+                else
+                    return nullptr;
+            }
+            _R operator()(void const *, EventArg<_Args>... args) { return (m_pOwner->*m_pMemFn)(std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(RawMemFunction const &rhs) const { return rhs.m_pOwner == m_pOwner && rhs.m_pMemFn == m_pMemFn; }
+
+        private:
+            _C *m_pOwner;
+            EventMemFnPtr<_C> m_pMemFn;
+        };
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 주소로 상수 멤버 함수를 담기 위한 클래스
+         * 
+         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         */
+        template <class _C>
+        class RawConstMemFunction
+        {
+        public:
+            RawConstMemFunction(_C const &owner, EventConstMemFnPtr<_C> pConstMemFn) : m_pOwner(&owner), m_pConstMemFn(pConstMemFn) {}
+            Trackable const *GetTrackable() const
+            {
+                if constexpr (std::derived_from<_C, Trackable>)
+                    return m_pOwner;
+                else
+                    return nullptr;
+            }
+            _R operator()(void const *, EventArg<_Args>... args) { return (m_pOwner->*m_pConstMemFn)(std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(RawConstMemFunction const &rhs) const { return rhs.m_pOwner == m_pOwner && rhs.m_pConstMemFn == m_pConstMemFn; }
+
+        private:
+            _C const *m_pOwner;
+            EventConstMemFnPtr<_C> m_pConstMemFn;
+        };
+        /**
+         * @brief 람다, 함수 객체 등 임의의 호출 가능한 객체를 레코드 안에 직접 담기 위한 클래스
+         * 
+         * 함수 객체끼리는 비교할 수 없으므로 핸들로만 등록 해제할 수 있다.
+         * 
+         * @tparam _F 호출 가능한 객체 타입
+         */
+        template <class _F>
+        class CallableFunction
+        {
+        public:
+            template <class _Fn>
+            explicit CallableFunction(_Fn &&fn) : m_fn(std::forward<_Fn>(fn)) {}
+            _R operator()(void const *, EventArg<_Args>... args) { return static_cast<_R>(std::invoke(m_fn, std::forward<EventArg<_Args>>(args)...)); }
+            bool operator==(CallableFunction const &) const { return false; }
+            _F &Get() { return m_fn; }
+
+        private:
+            _F m_fn;
+        };
+        /**
+         * @brief 레코드 안에 들어가지 않는 큰 호출 가능한 객체를 메모리 리소스에 담기 위한 클래스
+         * 
+         * 복사본도 원본과 같은 메모리 리소스에 할당된다.
+         * 
+         * @tparam _F 호출 가능한 객체 타입
+         */
+        template <class _F>
+        class HeapCallableFunction
+        {
+        public:
+            static constexpr std::size_t HeapSize = sizeof(_F);
+
+            template <class _Fn>
+            HeapCallableFunction(_Fn &&fn, std::pmr::memory_resource *pResource) : m_alloc(pResource), m_pFn(m_alloc.template new_object<_F>(std::forward<_Fn>(fn))) {}
+            HeapCallableFunction(HeapCallableFunction const &o) : m_alloc(o.m_alloc), m_pFn(m_alloc.template new_object<_F>(*o.m_pFn)) {}
+            HeapCallableFunction(HeapCallableFunction &&o) noexcept : m_alloc(o.m_alloc), m_pFn(std::exchange(o.m_pFn, nullptr)) {}
+            ~HeapCallableFunction()
+            {
+                if (m_pFn != nullptr)
+                    m_alloc.delete_object(m_pFn);
+            }
+            _R operator()(void const *, EventArg<_Args>... args) { return static_cast<_R>(std::invoke(*m_pFn, std::forward<EventArg<_Args>>(args)...)); }
+            bool operator==(HeapCallableFunction const &) const { return false; }
+            _F &Get() { return *m_pFn; }
+
+        private:
+            std::pmr::polymorphic_allocator<> m_alloc;
+            _F *m_pFn;
+        };
+        /**
+         * @brief 매개변수마다 span 하나씩을 받는 벌크 리스너를 담기 위한 클래스
+         * 
+         * InvokeBatch의 SoA 호출에서는 배치 전체를 한 번에 받고, 그 밖의 호출에서는 길이 1인 span들로 호출된다.
+         * 
+         * @tparam _Holder 호출 가능한 객체를 담은 CallableFunction 또는 HeapCallableFunction
+         */
+        template <class _Holder>
+        class BulkFunction
+        {
+        public:
+            static constexpr std::size_t HeapSize = [] { if constexpr (requires { _Holder::HeapSize; }) return _Holder::HeapSize; else return std::size_t(0); }();
+
+            explicit BulkFunction(_Holder &&holder) : m_holder(std::move(holder)) {}
+            _R operator()(void const *, EventArg<_Args>... args) { m_holder.Get()(ArgColumn<_Args>(std::addressof(args), 1)...); }
+            void InvokeBulk(ArgColumn<_Args>... columns) { m_holder.Get()(columns...); }
+            bool operator==(BulkFunction const &) const { return false; }
+
+        private:
+            _Holder m_holder;
+        };
+        /**
+         * @brief 호출 가능한 객체가 레코드 안에 직접 들어갈 수 있는지 확인
+         */
+        template <class _F>
+        static constexpr bool IsSmallCallable = sizeof(_F) <= FunctionStorageSize && alignof(_F) <= alignof(void *) && std::is_nothrow_move_constructible_v<_F>;
+        /**
+         * @brief 호출 가능한 객체를 담은 레코드 생성
+         * 
+         * 작은 객체는 레코드 안에 직접 담아 할당이 일어나지 않고, 큰 객체만 pResource에 할당한다.
+         */
+        template <class _F>
+        static auto MakeCallable(_F &&fn, std::pmr::memory_resource *pResource = std::pmr::get_default_resource())
+        {
+            using Callable = std::decay_t<_F>;
+            if constexpr (IsSmallCallable<Callable>)
+                return CallableFunction<Callable>(std::forward<_F>(fn));
+            else
+                return HeapCallableFunction<Callable>(std::forward<_F>(fn), pResource);
+        }
+        /**
+         * @brief 이벤트에 등록될 함수를 담기 위한 고정 크기 레코드
+         * 
+         * 기존에는 Function을 가상 클래스로 두고 파생 클래스를 힙에 할당해 list로 관리했지만
+         * 리스너마다 힙 할당이 두 번(list 노드, Function 객체) 일어나고 호출 시 포인터를 따라가야 해서 캐시 효율이 나빴다.\n
+         * 따라서 NonMemFunction, MemFunction, ConstMemFunction, CallableFunction을 레코드 내부 저장 공간에 그대로 담고
+         * 타입별로 하나씩 존재하는 연산 테이블(Ops)을 통해 호출, 비교, 복사, 이동, 소멸을 처리한다.\n
+         * 이 레코드들을 vector에 연속으로 담아 호출 시 선형으로 순회한다.\n
+         * 소유 객체가 있는 함수 객체는 Lock으로 소유 객체를 잠근 뒤 호출하며, 잠금에 실패하면 예외 없이 만료 표시만 한다.
+         */
+        class Function
+        {
+            /**
+             * @brief 저장된 함수 객체 타입별 연산 테이블
+             */
+            struct Ops
+            {
+                _R (*pfnInvoke)(void *pStorage, void const *pOwner, EventArg<_Args>... args);
+                void (*pfnInvokeBulk)(void *pStorage, ArgColumn<_Args>... columns);
+                std::shared_ptr<void const> (*pfnLock)(void const *pStorage);
+                bool (*pfnIsOwnerExpired)(void const *pStorage);
+                bool (*pfnEqual)(void const *pLhs, void const *pRhs);
+                void (*pfnCopy)(void *pDst, void const *pSrc);
+                void (*pfnMove)(void *pDst, void *pSrc) noexcept;
+                void (*pfnDestroy)(void *pStorage) noexcept;
+                Trackable const *(*pfnGetTrackable)(void const *pStorage);
+                std::size_t nHeapSize;
+            };
+            template <class _Fn>
+            static constexpr bool IsOwned = requires(_Fn const &fn) { fn.Lock(); };
+            template <class _Fn>
+            static std::shared_ptr<void const> LockOwner(void const *pStorage)
+            {
+                if constexpr (IsOwned<_Fn>) return static_cast<_Fn const *>(pStorage)->Lock();
+                else return nullptr;
+            }
+            template <class _Fn>
+            static constexpr bool HasBulk = requires { &_Fn::InvokeBulk; };
+            template <class _Fn>
+            static constexpr Ops s_ops = {
+                [](void *pStorage, void const *pOwner, EventArg<_Args>... args) -> _R { return (*static_cast<_Fn *>(pStorage))(pOwner, std::forward<EventArg<_Args>>(args)...); },
+                [] {
+                    if constexpr (HasBulk<_Fn>)
+                        return +[](void *pStorage, ArgColumn<_Args>... columns) { static_cast<_Fn *>(pStorage)->InvokeBulk(columns...); };
+                    else
+                        return static_cast<void (*)(void *, ArgColumn<_Args>...)>(nullptr);
+                }(),
+                IsOwned<_Fn> ? &LockOwner<_Fn> : nullptr,
+                [](void const *pStorage) { if constexpr (IsOwned<_Fn>) return static_cast<_Fn const *>(pStorage)->IsOwnerExpired(); else return false; },
+                [](void const *pLhs, void const *pRhs) { return *static_cast<_Fn const *>(pLhs) == *static_cast<_Fn const *>(pRhs); },
+                [](void *pDst, void const *pSrc) { ::new (pDst) _Fn(*static_cast<_Fn const *>(pSrc)); },
+                [](void *pDst, void *pSrc) noexcept { ::new (pDst) _Fn(std::move(*static_cast<_Fn *>(pSrc))); },
+                [](void *pStorage) noexcept { static_cast<_Fn *>(pStorage)->~_Fn(); },
+                [](void const *pStorage) -> Trackable const *
+                {
+                    if constexpr (requires(_Fn const &fn) { fn.GetTrackable(); })
+                        return static_cast<_Fn const *>(pStorage)->GetTrackable();
+                    else
+                        return nullptr;
+                },
+                [] { if constexpr (requires { _Fn::HeapSize; }) return _Fn::HeapSize; else return std::size_t(0); }()
+            };
+
+        public:
+            template <class _Fn>
+            explicit Function(_Fn &&fn) requires(!std::same_as<std::remove_cvref_t<_Fn>, Function>)
+                : m_pOps(&s_ops<std::remove_cvref_t<_Fn>>)
+            {
+                static_assert(sizeof(std::remove_cvref_t<_Fn>) <= FunctionStorageSize);
+                ::new (m_storage) std::remove_cvref_t<_Fn>(std::forward<_Fn>(fn));
+            }
+            Function(Function const &o) : m_pOps(o.m_pOps), m_slot(o.m_slot), m_priority(o.m_priority), m_bExpired(o.m_bExpired) { m_pOps->pfnCopy(m_storage, o.m_storage); }
+            Function(Function &&o) noexcept : m_pOps(o.m_pOps), m_slot(o.m_slot), m_priority(o.m_priority), m_bExpired(o.m_bExpired) { m_pOps->pfnMove(m_storage, o.m_storage); }
+            ~Function() { m_pOps->pfnDestroy(m_storage); }
+            Function& operator=(Function const &o)
+            {
+                if (this != &o)
+                {
+                    Function tmp(o);
+                    *this = std::move(tmp);
+                }
+                return *this;
+            }
+            Function& operator=(Function &&o) noexcept
+            {
+                if (this != &o)
+                {
+                    m_pOps->pfnDestroy(m_storage);
+                    m_pOps = o.m_pOps;
+                    m_slot = o.m_slot;
+                    m_priority = o.m_priority;
+                    m_bExpired = o.m_bExpired;
+                    m_pOps->pfnMove(m_storage, o.m_storage);
+                }
+                return *this;
+            }
+
+            /**
+             * @brief 소유 객체가 있는 함수인지 확인
+             */
+            bool HasOwner() const { return m_pOps->pfnLock != nullptr; }
+            /**
+             * @brief 배치 전체를 span으로 받는 벌크 리스너인지 확인
+             */
+            bool IsBulk() const { return m_pOps->pfnInvokeBulk != nullptr; }
+            /**
+             * @brief 벌크 리스너에 배치 전체를 전달
+             * 
+             * @param columns 매개변수별 값들
+             */
+            void InvokeBulk(ArgColumn<_Args>... columns) { m_pOps->pfnInvokeBulk(m_storage, columns...); }
+            /**
+             * @brief 소유 객체를 잠가 호출하는 동안 소멸되지 않도록 한다.
+             * 
+             * @return 소유 객체, 소유 객체가 소멸되었다면 nullptr
+             */
+            std::shared_ptr<void const> Lock() const { return m_pOps->pfnLock(m_storage); }
+            /**
+             * @brief 잠그지 않고 소유 객체가 소멸되었는지 확인
+             */
+            bool IsOwnerExpired() const { return m_pOps->pfnIsOwnerExpired(m_storage); }
+            /**
+             * @brief 객체 참조로 바인딩된 소유 객체가 Trackable이라면 그 객체, 아니라면 nullptr
+             */
+            Trackable const *GetTrackable() const { return m_pOps->pfnGetTrackable(m_storage); }
+            /**
+             * @brief 레코드 밖 힙에 할당된 함수 객체 크기, 레코드 안에 담겼다면 0
+             */
+            std::size_t GetHeapSize() const { return m_pOps->nHeapSize; }
+            /**
+             * @brief 호출 중 만료되었거나 등록 해제되어 다음 정리 때 제거될 레코드인지 확인
+             */
+            bool IsExpired() const { return m_bExpired; }
+            void MarkExpired() { m_bExpired = true; }
+            /**
+             * @brief 이 레코드를 가리키는 핸들 슬롯 인덱스
+             */
+            std::uint32_t GetSlot() const { return m_slot; }
+            void SetSlot(std::uint32_t slot) { m_slot = slot; }
+            /**
+             * @brief 호출 우선순위, 높을수록 먼저 호출된다.
+             */
+            int GetPriority() const { return m_priority; }
+            void SetPriority(int priority) { m_priority = priority; }
+
+            /**
+             * @brief 저장된 함수 호출
+             * 
+             * @param pOwner Lock으로 잠근 소유 객체, 소유 객체가 없는 함수라면 nullptr
+             * @param args 함수 호출에 필요한 매개변수
+             */
+            _R operator()(void const *pOwner, EventArg<_Args>... args) { return m_pOps->pfnInvoke(m_storage, pOwner, std::forward<EventArg<_Args>>(args)...); }
+            bool operator==(Function const &rhs) const { return m_pOps == rhs.m_pOps && m_pOps->pfnEqual(m_storage, rhs.m_storage); }
+
+        private:
+            alignas(void *) std::byte m_storage[FunctionStorageSize];
+            Ops const *m_pOps;
+            std::uint32_t m_slot = ListenerHandle::InvalidIndex;
+            int m_priority = 0;
+            bool m_bExpired = false;
+        };
+#pragma endregion
+#pragma region Define Awaiter
+        /**
+         * @brief Next()로 중단된 코루틴들을 잇는 침습형 목록의 노드
+         * 
+         * 대기 객체 안에 들어있으므로 기다릴 때 할당이 일어나지 않는다.\n
+         * ppPrevNext는 이 노드를 가리키는 포인터(목록의 머리 또는 앞 노드의 pNext)의 주소이며, 목록에 없다면 nullptr이다.
+         */
+        struct Waiter
+        {
+            void LinkFront(Waiter *&pHead)
+            {
+                pNext = pHead;
+                if (pNext != nullptr)
+                    pNext->ppPrevNext = &pNext;
+                pHead = this;
+                ppPrevNext = &pHead;
+            }
+            void Unlink()
+            {
+                if (ppPrevNext == nullptr)
+                    return;
+                *ppPrevNext = pNext;
+                if (pNext != nullptr)
+                    pNext->ppPrevNext = ppPrevNext;
+                ppPrevNext = nullptr;
+                pNext = nullptr;
+            }
+
+            Waiter **ppPrevNext = nullptr;
+            Waiter *pNext = nullptr;
+            std::coroutine_handle<> handle;
+            std::optional<std::tuple<std::remove_cvref_t<_Args>...>> value;
+        };
+        /**
+         * @brief 호출 매개변수를 받은 대기 객체들, 소멸될 때(리스너 호출이 모두 끝난 뒤) 기다리기 시작한 순서대로 한 번에 재개한다.
+         */
+        class WaiterBatch
+        {
+        public:
+            template <class... _Ts>
+            WaiterBatch(Waiter *pWaiters, _Ts const &...args)
+            {
+                // 이벤트의 목록은 나중에 기다린 대기 객체가 앞에 있으므로 뒤집어서 옮긴다.
+                while (pWaiters != nullptr)
+                {
+                    Waiter *pWaiter = pWaiters;
+                    pWaiters = pWaiter->pNext;
+                    pWaiter->value.emplace(args...);
+                    pWaiter->LinkFront(m_pHead);
+                }
+            }
+            WaiterBatch(WaiterBatch const &) = delete;
+            ~WaiterBatch()
+            {
+                while (m_pHead != nullptr)
+                {
+                    Waiter *pWaiter = m_pHead;
+                    pWaiter->Unlink();
+                    pWaiter->handle.resume();
+                }
+            }
+            WaiterBatch& operator=(WaiterBatch const &) = delete;
+
+        private:
+            Waiter *m_pHead = nullptr;
+        };
+        /**
+         * @brief 제한 시간이 없는 대기에 사용하는 빈 실행기
+         */
+        struct NoTimeout
+        {
+            using Duration = std::chrono::nanoseconds;
+            struct Timer
+            {
+                Timer(void (*)(void *), void *) {}
+            };
+        };
+    public:
+        /**
+         * @brief Next()로 받는 호출 매개변수, 참조와 cv 한정자를 뗀 값으로 복사된다.
+         */
+        using ArgsTuple = std::tuple<std::remove_cvref_t<_Args>...>;
+        /**
+         * @brief Next()가 반환하는 대기 객체
+         * 
+         * co_await하면 코루틴이 이벤트의 대기 목록에 연결되어 다음 호출까지 중단된다.\n
+         * 이벤트를 호출하면 리스너들이 모두 호출된 뒤 대기 중인 코루틴들이 기다리기 시작한 순서대로 호출한 스레드에서 재개된다.
+         * 
+         * @tparam _Executor 제한 시간을 재는 실행기 (ex. LocalExecutor), 제한 시간이 없다면 NoTimeout
+         * @tparam _bCancellable 취소되거나 제한 시간이 지날 수 있는지 여부, true라면 결과가 std::optional로 감싸진다.
+         */
+        template <class _Executor, bool _bCancellable>
+        class NextAwaiter
+        {
+            friend Event;
+            struct CancelCallback
+            {
+                NextAwaiter *pAwaiter;
+                void operator()() const noexcept { OnCancel(pAwaiter); }
+            };
+            static constexpr bool HasTimeout = !std::same_as<_Executor, NoTimeout>;
+
+        public:
+/// @cond
+            NextAwaiter(NextAwaiter const &) = delete;
+            ~NextAwaiter()
+            {
+                Disarm();
+                m_waiter.Unlink();
+            }
+            NextAwaiter& operator=(NextAwaiter const &) = delete;
+/// @endcond
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                if constexpr (_bCancellable)
+                {
+                    if (m_token.stop_requested())
+                        return false;
+                }
+                m_waiter.handle = handle;
+                m_waiter.LinkFront(m_pEvent->m_pWaiters);
+                if constexpr (HasTimeout)
+                    m_pExecutor->Schedule(m_timer, m_timeout);
+                if constexpr (_bCancellable)
+                {
+                    if (m_token.stop_possible())
+                        m_stopCallback.emplace(m_token, CancelCallback{ this });
+                }
+                return true;
+            }
+            auto await_resume()
+            {
+                Disarm();
+                if constexpr (_bCancellable)
+                    return std::move(m_waiter.value);
+                else
+                    return std::move(*m_waiter.value);
+            }
+
+        private:
+            NextAwaiter(Event &event, _Executor *pExecutor, typename _Executor::Duration timeout, std::stop_token token)
+                : m_pEvent(&event), m_pExecutor(pExecutor), m_timeout(timeout), m_token(std::move(token)) {}
+            void Disarm()
+            {
+                if constexpr (HasTimeout)
+                    m_pExecutor->Cancel(m_timer);
+                if constexpr (_bCancellable)
+                    m_stopCallback.reset();
+            }
+            /**
+             * @brief 제한 시간이 지나거나 취소되었을 때 빈 결과로 재개
+             * 
+             * 이미 이벤트가 호출되어 재개를 기다리는 중이라면 이벤트의 결과를 따른다.
+             */
+            static void OnCancel(void *pContext)
+            {
+                auto pAwaiter = static_cast<NextAwaiter *>(pContext);
+                if (pAwaiter->m_waiter.value)
+                    return;
+                pAwaiter->m_waiter.Unlink();
+                pAwaiter->m_waiter.handle.resume();
+            }
+
+            Event *m_pEvent;
+            Waiter m_waiter;
+            _Executor *m_pExecutor;
+            typename _Executor::Duration m_timeout;
+            [[no_unique_address]] typename _Executor::Timer m_timer{ &OnCancel, this };
+            std::stop_token m_token;
+            std::optional<std::stop_callback<CancelCallback>> m_stopCallback;
+        };
+#pragma endregion
+    private:
+        struct Storage;
+    public:
+/// @cond
+        Event() = default;
+        Event(Event const &o) { *this = o; }
+        Event(Event &&o) noexcept : m_pResource(o.m_pResource) { *this = std::move(o); }
+        ~Event()
+        {
+            // 이벤트가 소멸되면 다시 호출될 수 없으므로 대기 중인 코루틴들을 목록에서 떼어낸다.
+            while (m_pWaiters != nullptr)
+                m_pWaiters->Unlink();
+        }
+        /**
+         * 핸들을 한 번도 발급하지 않은 이벤트에 대입하면(복사 생성 포함) 리스너 저장소를 공유하기만 하므로 리스너 수와 관계없이 O(1)이다.\n
+         * 공유 중인 저장소는 어느 한쪽이 리스너를 바꿀 때 처음으로 복제되며, 원본에서 받은 핸들은 복사본에서도 같은 리스너를 가리킨다.\n
+         * Trackable 소유 객체에 바인딩된 리스너가 있다면 복사본도 소유 객체에 연결되어야 하므로 리스너마다 복사한다.\n
+         * 이미 리스너가 등록된 이벤트에 대입하면 기존처럼 o의 리스너들을 뒤에 추가한다.
+         */
+        Event& operator=(Event const &o)
+        {
+            std::shared_ptr<Storage> pSource = o.m_pStorage;
+            if (!pSource)
+                return *this;
+            if (m_nDispatchDepth == 0 && (!m_pStorage || m_pStorage->slots.empty()) && !pSource->bHasTrackable)
+            {
+                m_pStorage = std::move(pSource);
+                return *this;
+            }
+            for (std::size_t i = 0; i < pSource->listeners.size(); ++i)
+                if (!pSource->listeners[i].IsExpired())
+                    Push(Function(pSource->listeners[i]));
+            for (std::size_t i = 0; i < pSource->pending.size(); ++i)
+                Push(Function(pSource->pending[i]));
+            return *this;
+        }
+        Event& operator=(Event &&o) noexcept
+        {
+            if (this != &o)
+            {
+                m_pStorage = std::move(o.m_pStorage);
+                m_pLifetime = std::move(o.m_pLifetime);
+                if (m_pLifetime)
+                    *m_pLifetime = this;
+                m_instrument = std::move(o.m_instrument);
+                SpliceWaiters(o);
+            }
+            return *this;
+        }
+/// @endcond
+        /**
+         * @brief 리스너 저장소를 pResource에 할당하는 이벤트 생성
+         * 
+         * 리스너 레코드와 핸들 슬롯, 레코드에 들어가지 않는 큰 호출 가능한 객체가 모두 pResource에 할당되므로
+         * 프레임이나 하위 시스템 단위의 아레나(std::pmr::monotonic_buffer_resource 등)에 이벤트를 둘 수 있다.\n
+         * pResource는 이벤트와 이벤트를 복사해 저장소를 공유하는 복사본들보다 오래 살아있어야 한다.
+         * (큰 호출 가능한 객체는 다른 이벤트로 복사되어도 처음 등록된 이벤트의 메모리 리소스에 할당된다.)\n
+         * std::pmr 컨테이너와 같이 복사나 이동 대입으로는 메모리 리소스가 옮겨지지 않는다.
+         * (복사 생성된 이벤트는 기본 메모리 리소스를 사용하고, 이동 생성된 이벤트는 원본의 메모리 리소스를 사용한다.)
+         * 
+         * @param pResource 리스너 저장소를 할당할 메모리 리소스
+         */
+        explicit Event(std::pmr::memory_resource *pResource) : m_pResource(pResource) {}
+        /**
+         * @brief o를 복사하되 이후의 할당은 pResource에서 하는 이벤트 생성
+         * 
+         * @param o 복사할 이벤트
+         * @param pResource 리스너 저장소를 할당할 메모리 리소스
+         */
+        Event(Event const &o, std::pmr::memory_resource *pResource) : m_pResource(pResource) { *this = o; }
+        explicit Event(EventFnPtr pFn) { *this += pFn; }
+        template <non_constant _C>
+        explicit Event(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn) { AddListener(pOwner, pMemFn); }
+        template <class _C>
+        explicit Event(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn) { AddListener(pOwner, pConstMemFn); }
+
+#pragma region 구현하면서 불가능 했던 점
+        // note #1 : 템플릿 생성자는 템플릿 타입 매개변수를 추론을 통해서만 알 수 있다.
+        // 템플릿 생성자는 템플릿 타입 매개변수를 추론을 통해서만 알 수 있기 떄문에
+        // 추론이 불가능하도록 _C를 구성하면 안된다.
+        // 따라서 _C에 (const std::remove_const_t<_C>)는 _C를 추론하기에 알맞지 않으므로 이렇게 작성하는 것은 불가능하다.
+        //template <class _C>
+        //explicit Event(std::shared_ptr<const std::remove_const_t<_C>> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn) { AddListener(pOwner, pConstMemFn); }
+#pragma endregion
+
+        /**
+         * @brief 반환값이 존재하는 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 함수의 반환 값
+        */
+        std::list<_R> operator()(EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            auto waiters = TakeWaiters(args...);
+            std::list<_R> rvs;
+            Dispatch([&](Function &fn, void const *pOwner) { rvs.push_back(fn(pOwner, std::forward<EventArg<_Args>>(args)...)); return true; });
+            return rvs;
+        }
+        /**
+         * @brief 반환값이 존재하지 않는 함수 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         */
+        void operator()(EventArg<_Args>... args) const
+        {
+            auto waiters = TakeWaiters(args...);
+            Dispatch([&](Function &fn, void const *pOwner) { fn(pOwner, std::forward<EventArg<_Args>>(args)...); return true; });
+        }
+        /**
+         * @brief 결합기로 반환 값들을 합치는 함수 호출
+         * 
+         * 반환 값을 list에 모으지 않으므로 할당이 일어나지 않는다.\n
+         * ex) event.Invoke<Combiner::Sum>(args...), event.Invoke<Combiner::Or>(args...)
+         * 
+         * @tparam _Combiner 반환 타입으로 인스턴스화할 결합기 템플릿
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 결합기의 GetResult() 결과
+         */
+        template <template <typename> class _Combiner>
+            requires(non_void<_R> && result_combiner<_Combiner<_R>, _R>)
+        auto Invoke(EventArg<_Args>... args) const
+        {
+            _Combiner<_R> combiner;
+            return Invoke(combiner, std::forward<EventArg<_Args>>(args)...);
+        }
+        /**
+         * @brief 사용자가 만든 결합기 객체로 반환 값들을 합치는 함수 호출
+         * 
+         * @param combiner 반환 값을 누적할 결합기, 호출이 끝난 후에도 상태가 남아있다.
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 결합기의 GetResult() 결과
+         */
+        template <class _Combiner>
+            requires(non_void<_R> && result_combiner<_Combiner, _R>)
+        decltype(auto) Invoke(_Combiner &combiner, EventArg<_Args>... args) const
+        {
+            auto waiters = TakeWaiters(args...);
+            Dispatch([&](Function &fn, void const *pOwner) { return static_cast<bool>(combiner(fn(pOwner, std::forward<EventArg<_Args>>(args)...))); });
+            return combiner.GetResult();
+        }
+        /**
+         * @brief 반환 값들을 출력 반복자에 순서대로 기록하는 함수 호출
+         * 
+         * @param out 반환 값을 기록할 출력 반복자
+         * @param args 함수 호출에 필요한 매개변수
+         * @return _OutIt 마지막으로 기록한 다음 위치
+         */
+        template <std::output_iterator<_R> _OutIt>
+            requires(non_void<_R>)
+        _OutIt InvokeTo(_OutIt out, EventArg<_Args>... args) const
+        {
+            auto waiters = TakeWaiters(args...);
+            Dispatch([&](Function &fn, void const *pOwner) { *out++ = fn(pOwner, std::forward<EventArg<_Args>>(args)...); return true; });
+            return out;
+        }
+        /**
+         * @brief 반환 값들을 pResource에 할당한 vector에 모으는 함수 호출
+         * 
+         * operator()와 같지만 반환 값 버퍼를 호출자가 정한 메모리 리소스(프레임 아레나 등)에 할당한다.
+         * 
+         * @param pResource 반환 값 버퍼를 할당할 메모리 리소스
+         * @param args 함수 호출에 필요한 매개변수
+         * @return std::pmr::vector<_R> 등록 순서대로 정렬된 반환 값
+         */
+        std::pmr::vector<_R> Collect(std::pmr::memory_resource *pResource, EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            std::pmr::vector<_R> rvs(pResource);
+            if (m_pStorage)
+                rvs.reserve(m_pStorage->listeners.size() - m_pStorage->nExpired);
+            InvokeTo(std::back_inserter(rvs), std::forward<EventArg<_Args>>(args)...);
+            return rvs;
+        }
+        /**
+         * @brief 반환 값들을 호출자가 제공한 버퍼에 순서대로 기록하는 함수 호출
+         * 
+         * 모든 리스너가 호출되지만 버퍼 크기를 넘는 반환 값은 버려진다.
+         * 
+         * @param buffer 반환 값을 기록할 버퍼
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 호출된 리스너 수, buffer.size()보다 크다면 버퍼가 모자랐다는 뜻이다.
+         */
+        std::size_t InvokeTo(std::span<_R> buffer, EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            auto waiters = TakeWaiters(args...);
+            std::size_t n = 0;
+            Dispatch([&](Function &fn, void const *pOwner)
+            {
+                if (n < buffer.size())
+                    buffer[n] = fn(pOwner, std::forward<EventArg<_Args>>(args)...);
+                else
+                    fn(pOwner, std::forward<EventArg<_Args>>(args)...);
+                ++n;
+                return true;
+            });
+            return n;
+        }
+        /**
+         * @brief 반환값이 존재하지 않는 함수 타입에 대한 병렬 호출
+         * 
+         * 리스너 목록을 조각으로 나눠 pool.ParallelFor(count, grain, fn(begin, end))로 호출한다. (ex. ThreadPool)\n
+         * 리스너들은 서로 독립적이어야 하며, 병렬 호출 중에는 이벤트에 리스너를 등록하거나 해제하면 안된다.
+         * - 소유 객체가 소멸된 리스너는 건너뛰고, 모든 호출이 끝난 뒤 호출한 스레드에서 한 번에 만료 표시한다.
+         * - 리스너가 예외를 던져도 나머지 리스너는 모두 호출되며, 끝난 뒤 등록 순서상 가장 앞선 리스너의 예외를 다시 던진다.
+         * 
+         * @param pool 리스너를 나눠 실행할 스레드 풀
+         * @param args 함수 호출에 필요한 매개변수
+         */
+        template <class _Pool>
+        void InvokeParallel(_Pool &pool, EventArg<_Args>... args) const
+        {
+            auto waiters = TakeWaiters(args...);
+            DispatchParallel(pool, [&](std::size_t, Function &fn, void const *pOwner) { fn(pOwner, std::forward<EventArg<_Args>>(args)...); });
+        }
+        /**
+         * @brief 반환값이 존재하는 타입에 대한 병렬 호출
+         * 
+         * 호출 방식은 반환값이 없는 InvokeParallel과 같다.
+         * 
+         * @param pool 리스너를 나눠 실행할 스레드 풀
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 등록 순서대로 정렬된 반환 값, 소유 객체가 소멸된 리스너의 값은 빠진다.
+         */
+        template <class _Pool>
+        std::vector<_R> InvokeParallel(_Pool &pool, EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            auto waiters = TakeWaiters(args...);
+            std::vector<std::optional<_R>> results(m_pStorage ? m_pStorage->listeners.size() : 0);
+            DispatchParallel(pool, [&](std::size_t i, Function &fn, void const *pOwner) { results[i].emplace(fn(pOwner, std::forward<EventArg<_Args>>(args)...)); });
+            std::vector<_R> rvs;
+            rvs.reserve(results.size());
+            for (auto &result : results)
+                if (result)
+                    rvs.push_back(std::move(*result));
+            return rvs;
+        }
+        /**
+         * @brief 여러 매개변수 묶음에 대한 일괄 호출 (AoS)
+         * 
+         * 한 리스너를 모든 묶음에 대해 호출한 뒤 다음 리스너로 넘어가므로(listener-major)
+         * 리스너 목록은 한 번만 순회하고, 소유 객체도 리스너마다 한 번만 잠그며, 같은 리스너의 코드와 데이터가 캐시에 남아있는 채로 반복된다.\n
+         * 따라서 호출 순서는 묶음마다 operator()를 부르는 것과 다르지만, 각 묶음에 대해 리스너들이 불리는 순서는 같다.
+         * - 리스너가 Propagation::Stop()을 호출하면 그 묶음에 대해서만 나머지 리스너를 호출하지 않는다.
+         * - 반환 값은 버려진다.
+         * - 벌크 리스너는 묶음마다 길이 1인 span들로 호출된다. 배치 전체를 한 번에 전달하려면 SoA 호출을 사용한다.
+         * - Next()로 기다리는 코루틴은 첫 번째 묶음을 받는다.
+         * 
+         * @param argSets 매개변수 묶음들
+         */
+        void InvokeBatch(std::span<ArgsTuple const> argSets) const
+            requires(std::is_convertible_v<std::remove_cvref_t<_Args> const &, EventArg<_Args>> && ...)
+        {
+            InvokeBatchAoS(argSets, std::index_sequence_for<_Args...>());
+        }
+        /**
+         * @brief 매개변수별 배열에 대한 일괄 호출 (SoA)
+         * 
+         * i번째 묶음은 각 배열의 i번째 값들이며, 가장 짧은 배열의 길이만큼 호출한다.\n
+         * 호출 방식은 AoS InvokeBatch와 같고, AddBulkListener로 등록한 벌크 리스너에는 배열들이 그대로 한 번에 전달된다.
+         * (Propagation::Stop()으로 일부 묶음이 중단되었다면 남은 묶음마다 따로 호출된다.)
+         * 
+         * ex) event.InvokeBatch(ids, positions);
+         * 
+         * @param columns 매개변수별 값 배열
+         */
+        void InvokeBatch(ArgColumn<_Args>... columns) const
+            requires(sizeof...(_Args) != 0 && (std::is_convertible_v<std::remove_cvref_t<_Args> const &, EventArg<_Args>> && ...))
+        {
+            std::size_t const count = std::min({ columns.size()... });
+            if (count == 0)
+                return;
+            auto waiters = TakeWaiters(columns[0]...);
+            DispatchBatch(count,
+                [&](Function &fn, void const *pOwner, std::size_t i) { fn(pOwner, columns[i]...); },
+                [&](Function &fn) { fn.InvokeBulk(columns.first(count)...); });
+        }
+        /**
+         * @brief 다음 호출까지 코루틴을 중단시키는 대기 객체
+         * 
+         * 대기 객체가 코루틴 프레임 안에서 목록의 노드가 되므로 기다릴 때 할당이 일어나지 않는다.\n
+         * 이벤트가 호출되면 리스너들이 모두 호출된 뒤 매개변수를 복사받아 재개되며,
+         * 다시 기다리려면 Next()를 다시 co_await해야 한다.\n
+         * 이벤트가 소멸되면 다시 호출될 수 없으므로 이 대기는 재개되지 않는다. 끝을 알아야 한다면 취소 가능한 Next를 사용한다.\n
+         * 이벤트와 마찬가지로 스레드 안전하지 않다.
+         * 
+         * ex) auto [a, b] = co_await event.Next();
+         * 
+         * @return NextAwaiter co_await하면 ArgsTuple을 반환하는 대기 객체
+         */
+        NextAwaiter<NoTimeout, false> Next() { return { *this, nullptr, {}, {} }; }
+        /**
+         * @brief 다음 호출이나 취소까지 코루틴을 중단시키는 대기 객체
+         * 
+         * token에 중단이 요청되면 빈 결과로 재개된다. 중단 요청은 이벤트를 사용하는 스레드에서 해야 한다.
+         * 
+         * @param token 대기를 취소할 때 사용할 중단 토큰
+         * @return NextAwaiter co_await하면 std::optional<ArgsTuple>을 반환하는 대기 객체
+         */
+        NextAwaiter<NoTimeout, true> Next(std::stop_token token) { return { *this, nullptr, {}, std::move(token) }; }
+        /**
+         * @brief 다음 호출이나 제한 시간, 취소까지 코루틴을 중단시키는 대기 객체
+         * 
+         * executor의 시간으로 timeout이 지나거나 token에 중단이 요청되면 빈 결과로 재개된다.\n
+         * 실행기는 Duration 타입과 Schedule(Timer &, Duration), Cancel(Timer &)을 제공해야 하며,
+         * Timer는 (void (*)(void *), void *)로 생성되어야 한다. (ex. LocalExecutor)
+         * 
+         * @param executor 제한 시간을 재는 실행기
+         * @param timeout 제한 시간
+         * @param token 대기를 취소할 때 사용할 중단 토큰
+         * @return NextAwaiter co_await하면 std::optional<ArgsTuple>을 반환하는 대기 객체
+         */
+        template <class _Executor>
+        NextAwaiter<_Executor, true> Next(_Executor &executor, typename _Executor::Duration timeout, std::stop_token token = {})
+        {
+            return { *this, &executor, timeout, std::move(token) };
+        }
+        /**
+         * @brief 이벤트에 함수 등록
+         * 
+         * AddListner와 동일\n
+         * 비멤버 함수에만 사용가능
+         * 
+         * @param pFn 등록할 함수 포인터
+         * @return Event& 자기 자신을 반환
+         */
+        Event& operator+=(EventFnPtr pFn)
+        {
+            AddListener(pFn);
+            return *this;
+        }
+        /**
+         * @brief 이벤트에 등록된 모든 함수를 제거하고 pFn 함수 등록 
+         * 
+         * @param pFn 등록할 함수 포인
+         * @return Event& 자기 자신을 반환
+         */
+        Event& operator=(EventFnPtr pFn)
+        {
+            RemoveAllListener();
+            *this += pFn;
+            return *this;
+        }
+        /**
+         * @brief pFn을 이벤트에서 등록 해제
+         * 
+         * @param pFn 등록 해제할 함수 포인터
+         * @return Event& 자기 자신을 반환
+         */
+        Event& operator-=(EventFnPtr pFn)
+        {
+            RemoveListener(Function(NonMemFunction(pFn)));
+            return *this;
+        }
+
+        /**
+         * @brief 일반 함수 등록
+         * 
+         * 리스너들은 등록할 때 우선순위 순서로 정렬된 위치에 들어가므로 호출 시에는 정렬하지 않는다.
+         * 
+         * @param pFn 등록할 함수 포인터
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pFn이 nullptr라면 유효하지 않은 핸들
+         */
+        ListenerHandle AddListener(EventFnPtr pFn, int priority = 0)
+        {
+            if (pFn == nullptr)
+                return {};
+            return Push(Function(NonMemFunction(pFn)), priority);
+        }
+        /**
+         * @brief 비상수 객체로부터 비상수 멤버 함수 등록
+         * 
+         * @param pOwner 비상수 멤버 함수를 호출할 비상수 객체
+         * @param pMemFn 등록할 비상수 멤버 함수
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <non_constant _C>
+        ListenerHandle AddListener(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn, int priority = 0)
+        {
+            if (pMemFn == nullptr)
+                return {};
+            return Push(Function(MemFunction<_C>(pOwner, pMemFn)), priority);
+        }
+        /**
+         * @brief 객체로부터 상수 멤버 함수 등록
+         * 
+         * @param pOwner 상수 멤버 함수를 호출할 객체
+         * @param pConstMemFn 등록할 상수 멤버 함수
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pConstMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <class _C>
+        ListenerHandle AddListener(std::shared_ptr<_C> const& pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn, int priority = 0)
+        {
+            if (pConstMemFn == nullptr)
+                return {};
+            return Push(Function(ConstMemFunction<const _C>(pOwner, pConstMemFn)), priority);
+        }
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 참조로 비상수 멤버 함수 등록
+         * 
+         * 호출 시 소유 객체를 잠그지 않으므로 원자적 연산 없이 멤버 함수를 바로 호출한다.\n
+         * 대신 소유 객체가 소멸되기 전에 반드시 등록 해제되어야 한다.
+         * 소유 객체가 Trackable을 상속했다면 소멸 시 자동으로 등록 해제되고,
+         * 그렇지 않다면 반환된 핸들이나 ScopedConnection으로 직접 등록 해제해야 한다.
+         * 
+         * @param owner 비상수 멤버 함수를 호출할 비상수 객체
+         * @param pMemFn 등록할 비상수 멤버 함수
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <non_constant _C>
+        ListenerHandle AddListener(_C &owner, EventMemFnPtr<_C> pMemFn, int priority = 0)
+        {
+            if (pMemFn == nullptr)
+                return {};
+            return Push(Function(RawMemFunction<_C>(owner, pMemFn)), priority);
+        }
+        /**
+         * @brief 소유 객체를 추적하지 않고 객체 참조로 상수 멤버 함수 등록
+         * 
+         * @param owner 상수 멤버 함수를 호출할 객체
+         * @param pConstMemFn 등록할 상수 멤버 함수
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들, pConstMemFn이 nullptr라면 유효하지 않은 핸들
+         */
+        template <class _C>
+        ListenerHandle AddListener(_C const &owner, EventConstMemFnPtr<_C> pConstMemFn, int priority = 0)
+        {
+            if (pConstMemFn == nullptr)
+                return {};
+            return Push(Function(RawConstMemFunction<_C>(owner, pConstMemFn)), priority);
+        }
+        /// @cond
+        template <class _C>
+        ListenerHandle AddListener(_C const &&, EventConstMemFnPtr<_C>, int = 0) = delete;
+        /// @endcond
+        /**
+         * @brief 람다, 함수 객체 등 호출 가능한 객체 등록
+         * 
+         * 캡처가 없는 람다는 함수 포인터로 변환되어 일반 함수로 등록되므로 이 함수를 사용하지 않는다.\n
+         * 작은 객체는 리스너 레코드 안에 직접 담기므로 할당이 일어나지 않고, 큰 객체만 힙에 할당한다.\n
+         * 함수 객체는 서로 비교할 수 없으므로 반환된 핸들로 등록 해제한다.
+         * 
+         * @param fn 등록할 호출 가능한 객체
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <class _F>
+            requires(!std::convertible_to<_F, EventFnPtr> && std::is_invocable_r_v<_R, std::decay_t<_F> &, EventArg<_Args>...>)
+        ListenerHandle AddListener(_F &&fn, int priority = 0)
+        {
+            return Push(Function(MakeCallable(std::forward<_F>(fn), m_pResource)), priority);
+        }
+        /**
+         * @brief 매개변수마다 span 하나씩을 받는 벌크 리스너 등록
+         * 
+         * SoA InvokeBatch에서는 배치 전체를 한 번에 받으므로 리스너 안에서 배열 단위로 처리(벡터화 등)할 수 있다.
+         * 그 밖의 호출에서는 길이 1인 span들로 호출된다.\n
+         * 반환값이 없는 이벤트에만 등록할 수 있으며, 등록 해제는 반환된 핸들로 한다.
+         * 
+         * ex) event.AddBulkListener([](std::span<int const> ids, std::span<float const> values) { ... });
+         * 
+         * @param fn 등록할 호출 가능한 객체
+         * @param priority 호출 우선순위, 높을수록 먼저 호출되고 같다면 등록 순서대로 호출된다.
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <class _F>
+            requires(std::is_void_v<_R> && sizeof...(_Args) != 0 && std::is_invocable_v<std::decay_t<_F> &, ArgColumn<_Args>...>)
+        ListenerHandle AddBulkListener(_F &&fn, int priority = 0)
+        {
+            auto holder = MakeCallable(std::forward<_F>(fn), m_pResource);
+            return Push(Function(BulkFunction<decltype(holder)>(std::move(holder))), priority);
+        }
+        /**
+         * @brief 핸들로 리스너 등록 해제
+         * 
+         * 리스너를 찾기 위해 순회하거나 비교하지 않으며 소유 객체도 잠그지 않는다.\n
+         * 이미 해제되었거나 소유 객체가 소멸되어 정리된 리스너의 핸들이라면 아무 일도 하지 않는다.
+         * 
+         * @param handle AddListener가 반환한 핸들
+         * @return 리스너가 해제되었는지 여부
+         */
+        bool RemoveListener(ListenerHandle handle)
+        {
+            if (!IsListening(handle))
+                return false;
+            Storage &storage = MakeUnique();
+            std::uint32_t index = storage.slots[handle.index].index;
+            if (index & PendingFlag)
+                ErasePending(index & ~PendingFlag);
+            else
+                Expire(storage.listeners[index]);
+            return true;
+        }
+        /**
+         * @brief 핸들이 가리키는 리스너가 아직 등록되어 있는지 확인
+         * 
+         * @param handle AddListener가 반환한 핸들
+         */
+        bool IsListening(ListenerHandle handle) const
+        {
+            return m_pStorage && handle.index < m_pStorage->slots.size() && m_pStorage->slots[handle.index].generation == handle.generation;
+        }
+        /**
+         * @brief 일반 함수 등록 해제
+         * 
+         * @param pFn 등록된 함수
+         */
+        void RemoveListener(EventFnPtr pFn) { *this -= pFn; }
+        /**
+         * @brief 비상수 객체로 등록된 비상수 멤버 함수 등록 해제
+         * 
+         * @tparam _C 등록한 비상수 객체 타입
+         * @param _pOwner 등록한 객체
+         * @param pMemFn 등록된 비상수 멤버 함수
+         */
+        template <non_constant _C>
+        void RemoveListener(std::shared_ptr<_C> const &_pOwner, EventMemFnPtr<_C> pMemFn)
+        {
+            RemoveListener(Function(MemFunction<_C>(_pOwner, pMemFn)));
+        }
+        /**
+         * @brief 객체로 등록된 상수 멤버 함수 등록 해제
          * 
-         * 이벤트에 등록할 함수를 따로 담기 위해 클래스를 제작하는 이유는
-         * 함수 포인터들을 list로 가지고 있어야 하는데 다양한 타입들에 대해서 하나의 list에 그냥 담을 수 없음
-         * 따라서 Function이라는 클래스를 만들고 모든 함수의 인터페이스는 같으므로 똑같은 인터페이스를 제공해주면서
-         * 하나의 list로 모든 함수포인터들을 담고 다룰 수 있음
+         * @tparam _C 등록한 객체 타입
+         * @param pOwner 등록한 객체
+         * @param pConstMemFn 등록된 상수 멤버 함수
          */
-        class Function
+        template <class _C>
+        void RemoveListener(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn)
         {
-        public:
-            virtual _R operator()(_Args... params) = 0;
-            virtual bool operator==(Function const &rhs) const = 0;
-            virtual std::unique_ptr<Function> Clone() const = 0;
-        };
+            RemoveListener(Function(ConstMemFunction<const _C>(pOwner, pConstMemFn)));
+        }
         /**
-         * @brief 비멤버 함수를 담기 위한 파생 클래스
+         * @brief 객체 참조로 등록된 비상수 멤버 함수 등록 해제
+         * 
+         * @param owner 등록한 객체
+         * @param pMemFn 등록된 비상수 멤버 함수
          */
-        class NonMemFunction : public Function
+        template <non_constant _C>
+        void RemoveListener(_C &owner, EventMemFnPtr<_C> pMemFn)
         {
-        public:
-            NonMemFunction(EventFnPtr pFn) : m_pFn(pFn) {}
-            virtual _R operator()(_Args... args) override { return m_pFn(args...); }
-            virtual bool operator==(Function const &rhs) const override
+            RemoveListener(Function(RawMemFunction<_C>(owner, pMemFn)));
+        }
+        /**
+         * @brief 객체 참조로 등록된 상수 멤버 함수 등록 해제
+         * 
+         * @param owner 등록한 객체
+         * @param pConstMemFn 등록된 상수 멤버 함수
+         */
+        template <class _C>
+        void RemoveListener(_C const &owner, EventConstMemFnPtr<_C> pConstMemFn)
+        {
+            RemoveListener(Function(RawConstMemFunction<_C>(owner, pConstMemFn)));
+        }
+        /**
+         * @brief 등록된 모든 함수들 삭제
+         * 
+         * 다른 복사본과 저장소를 공유 중이라면 리스너들을 복제하지 않고 빈 저장소로 바꾼다.
+         */
+        void RemoveAllListener()
+        {
+            if (!m_pStorage)
+                return;
+            if (!IsStorageUnique())
             {
-                try { return dynamic_cast<NonMemFunction const &>(rhs).m_pFn == m_pFn; }
-                catch (std::bad_cast e) { return false; }
+                ReplaceSharedStorage();
+                return;
             }
-            virtual std::unique_ptr<Function> Clone() const override { return std::make_unique<NonMemFunction>(m_pFn); }
-        private:
-            EventFnPtr m_pFn;
-        };
+            Storage &storage = *m_pStorage;
+            for (auto &fn : storage.pending)
+                ReleaseSlot(fn.GetSlot());
+            storage.pending.clear();
+            if (m_nDispatchDepth != 0)
+            {
+                // 호출 중인 반복이 이어질 수 있도록 레코드는 지우지 않고 만료 표시만 한다.
+                for (auto &fn : storage.listeners)
+                    if (!fn.IsExpired())
+                        Expire(fn);
+                return;
+            }
+            for (auto &fn : storage.listeners)
+                if (!fn.IsExpired())
+                    ReleaseSlot(fn.GetSlot());
+            storage.listeners.clear();
+            storage.nExpired = 0;
+            storage.bHasTrackable = false;
+        }
         /**
-         * @brief 비상수 멤버 함수를 담기 위한 파생 클래스
+         * @brief 등록된 리스너 수
          * 
-         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         * 등록 해제되었거나 소유 객체가 소멸된 것으로 확인된 리스너는 세지 않는다.
          */
-        template <class _C>
-        class MemFunction : public Function
+        std::size_t GetListenerCount() const { return m_pStorage ? m_pStorage->listeners.size() - m_pStorage->nExpired + m_pStorage->pending.size() : 0; }
+        /**
+         * @brief 리스너 저장소를 할당하는 메모리 리소스
+         */
+        std::pmr::memory_resource *GetMemoryResource() const { return m_pResource; }
+        /**
+         * @brief 이벤트가 사용 중인 메모리 크기(byte)
+         * 
+         * 이벤트 객체 자체와 리스너 레코드, 핸들 슬롯 버퍼의 용량, 힙에 할당된 함수 객체 크기의 합이다.\n
+         * 할당자 부가 비용과 소유 객체의 제어 블록은 포함하지 않으며, 복사본과 공유 중인 저장소는 각 복사본에 모두 더해진다.
+         */
+        std::size_t MemoryUsage() const
         {
-        public:
-            MemFunction(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn) : m_pOwner(pOwner), m_pMemFn(pMemFn) {}
-            virtual _R operator()(_Args... args) override
+            std::size_t size = sizeof(*this);
+            if (!m_pStorage)
+                return size;
+            size += sizeof(Storage) + (m_pStorage->listeners.capacity() + m_pStorage->pending.capacity()) * sizeof(Function) + m_pStorage->slots.capacity() * sizeof(Slot);
+            for (auto &fn : m_pStorage->listeners)
+                size += fn.GetHeapSize();
+            for (auto &fn : m_pStorage->pending)
+                size += fn.GetHeapSize();
+            return size;
+        }
+        /**
+         * @brief 만료 표시된 리스너들을 한 번에 제거
+         * 
+         * 호출 중 소유 객체가 소멸된 것이 확인된 리스너는 예외 없이 만료 표시만 되고 건너뛰어진다.\n
+         * 만료된 리스너가 전체의 절반을 넘으면 호출이 끝날 때 자동으로 정리되지만,
+         * 핫 패스 밖에서 미리 정리하고 싶을 때 직접 호출할 수 있다.\n
+         * 호출 중에는 반복 중인 레코드를 옮길 수 없으므로 아무 일도 하지 않고, 가장 바깥 호출이 끝날 때 정리된다.
+         * 
+         * @return 제거된 리스너 수
+         */
+        std::size_t Compact()
+        {
+            if (!m_pStorage || m_pStorage->nExpired == 0 || m_nDispatchDepth != 0)
+                return 0;
+            if (!IsStorageUnique())
             {
-                if (auto pShared = m_pOwner.lock())
-                    return ((*pShared).*m_pMemFn)(args...);
-                throw std::bad_weak_ptr();
+                std::size_t nExpired = m_pStorage->nExpired;
+                m_pStorage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(m_pResource), *m_pStorage, m_pResource);
+                return nExpired;
             }
-            virtual bool operator==(Function const &rhs) const override
+            Storage &storage = *m_pStorage;
+            auto nErased = std::erase_if(storage.listeners, [](Function const &fn) { return fn.IsExpired(); });
+            for (std::size_t i = 0; i < storage.listeners.size(); ++i)
+                storage.slots[storage.listeners[i].GetSlot()].index = static_cast<std::uint32_t>(i);
+            storage.nExpired = 0;
+            return nErased;
+        }
+        /**
+         * @brief 소유 객체가 소멸된 리스너들을 모두 찾아 제거
+         * 
+         * 아직 호출되지 않아 만료 표시가 되지 않은 리스너들도 소유 객체를 잠그지 않고 검사한다.\n
+         * 등록 해제로 남은 자리도 Compact로 함께 정리되지만 반환 값에는 세지 않는다.
+         * 소멸된 소유 객체가 없다면 공유 중인 저장소를 복제하지 않는다.
+         * 
+         * @return 이번에 소유 객체가 소멸된 것을 찾아 제거한 리스너 수
+         */
+        std::size_t PruneExpired()
+        {
+            if (!m_pStorage)
+                return 0;
+            auto isOwnerExpired = [](Function const &fn) { return !fn.IsExpired() && fn.HasOwner() && fn.IsOwnerExpired(); };
+            std::size_t nPruned = 0;
+            if (std::ranges::any_of(m_pStorage->listeners, isOwnerExpired))
             {
-                try
+                for (auto &fn : MakeUnique().listeners)
                 {
-                    auto const &rhsFn = dynamic_cast<MemFunction const &>(rhs);
-                    auto pOwnerLhs = m_pOwner.lock();
-                    auto pOwnerRhs = rhsFn.m_pOwner.lock();
-                    if (pOwnerLhs && pOwnerRhs)
-                        return rhsFn.m_pMemFn == m_pMemFn && pOwnerLhs == pOwnerRhs;
-                    throw std::bad_weak_ptr();
+                    if (isOwnerExpired(fn))
+                    {
+                        ExpireOwner(fn);
+                        ++nPruned;
+                    }
                 }
-                catch (std::bad_cast e) { return false; }
             }
-            virtual std::unique_ptr<Function> Clone() const override
-            { return std::make_unique<MemFunction>(m_pOwner.lock(), m_pMemFn); }
-
-        private:
-            std::weak_ptr<_C> m_pOwner;
-            EventMemFnPtr<_C> m_pMemFn;
-        };
+            Compact();
+            return nPruned;
+        }
+        /**
+         * @brief 이 이벤트의 계측 정책 객체
+         * 
+         * EventStats라면 통계를 읽거나 리스너별 훅을 설정할 때 사용한다.
+         */
+        _Instrument &GetInstrument() { return m_instrument; }
+        _Instrument const &GetInstrument() const { return m_instrument; }
 
+    private:
         /**
-         * @brief 상수 멤버 함수를 담기 위한 파생 클래스
+         * @brief 만료되지 않은 리스너들을 우선순위, 등록 순서대로 호출
          * 
-         * @tparam _C 해당 함수를 보유하고 있는 클래스
+         * 소유 객체가 소멸된 리스너는 예외를 던지지 않고 만료 표시 후 건너뛴다.\n
+         * 리스너가 Propagation::Stop()을 호출하면 나머지 리스너는 호출하지 않는다.
+         * 
+         * @param call 리스너와 잠근 소유 객체를 받아 실제 호출을 수행하는 함수 객체, false를 반환하면 나머지 리스너는 호출하지 않는다.
          */
-        template <constant _C>
-        class ConstMemFunction : public Function
+        template <class _Call>
+        void Dispatch(_Call &&call) const
+        {
+            DispatchScope scope(*this);
+            if constexpr (_Instrument::Enabled)
+            {
+                auto begin = m_instrument.BeginDispatch();
+                std::size_t nCalled = 0;
+                DispatchListeners([&](Function &fn, void const *pOwner)
+                {
+                    ++nCalled;
+                    return CallInstrumented(fn, [&] { return call(fn, pOwner); });
+                });
+                m_instrument.EndDispatch(begin, nCalled);
+            }
+            else
+                DispatchListeners(call);
+        }
+        /**
+         * @brief 이 이벤트의 호출 하나를 감싸는 객체
+         * 
+         * 생성될 때 호출 깊이를 올리고 바깥 호출의 전파 상태를 떼어두며,
+         * 소멸될 때 전파 상태와 깊이를 되돌리고 가장 바깥 호출이었다면 미뤄둔 변경을 반영한다.\n
+         * 리스너가 예외를 던져도 소멸자에서 같은 일을 하므로 바깥 호출이 멈추거나 추가 대기 중인 리스너가 남지 않는다.
+         * 예외가 전파되는 중에 변경을 반영하다 생긴 예외는 삼키고 리스너의 예외를 그대로 전달한다.
+         */
+        class DispatchScope
         {
         public:
-            ConstMemFunction(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<_C> pConstMemFn) : m_pOwner(pOwner), m_pConstMemFn(pConstMemFn) {}
-            virtual _R operator()(_Args... args) override
+            explicit DispatchScope(Event const &event)
+                : m_event(event), m_bOuterStopped(std::exchange(Propagation::s_bStopped, false)), m_nUncaught(std::uncaught_exceptions())
             {
-                if (auto pShared = m_pOwner.lock())
-                    return ((*pShared).*m_pConstMemFn)(args...);
-                throw std::bad_weak_ptr();
+                ++m_event.m_nDispatchDepth;
             }
-            virtual bool operator==(Function const &rhs) const override
+            DispatchScope(DispatchScope const &) = delete;
+            ~DispatchScope() noexcept(false)
             {
-                try
+                Propagation::s_bStopped = m_bOuterStopped;
+                if (--m_event.m_nDispatchDepth != 0)
+                    return;
+                if (std::uncaught_exceptions() == m_nUncaught)
+                    m_event.FinishDispatch();
+                else
                 {
-                    auto const &rhsFn = dynamic_cast<ConstMemFunction const &>(rhs);
-                    auto pOwnerLhs = m_pOwner.lock();
-                    auto pOwnerRhs = rhsFn.m_pOwner.lock();
-                    if (pOwnerLhs && pOwnerRhs)
-                        return rhsFn.m_pConstMemFn == m_pConstMemFn && pOwnerLhs == pOwnerRhs;
-                    throw std::bad_weak_ptr();
+                    try { m_event.FinishDispatch(); }
+                    catch (...) {}
                 }
-                catch (std::bad_cast e) { return false; }
             }
-            virtual std::unique_ptr<Function> Clone() const override
-            { return std::make_unique<ConstMemFunction>(m_pOwner.lock(), m_pConstMemFn); }
+            DispatchScope& operator=(DispatchScope const &) = delete;
 
         private:
-            std::weak_ptr<_C> m_pOwner;
-            EventConstMemFnPtr<_C> m_pConstMemFn;
+            Event const &m_event;
+            bool m_bOuterStopped;
+            int m_nUncaught;
         };
-#pragma endregion
-    public:
-/// @cond
-        Event() = default;
-        Event(Event const &o) { *this = o; }
-        Event(Event &&) = default;
-        ~Event() = default;
-        Event& operator=(Event const &o)
-        {
-            for (auto& listener : o.m_listeners)
-                m_listeners.push_back(listener->Clone());
-            return *this;
-        }
-        Event& operator=(Event &&) = default;
-/// @endcond
-        explicit Event(EventFnPtr pFn) { *this += pFn; }
-        template <non_constant _C>
-        explicit Event(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn) { AddListener(pOwner, pMemFn); }
-        template <class _C>
-        explicit Event(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn) { AddListener(pOwner, pConstMemFn); }
-
-#pragma region 구현하면서 불가능 했던 점
-        // note #1 : 템플릿 생성자는 템플릿 타입 매개변수를 추론을 통해서만 알 수 있다.
-        // 템플릿 생성자는 템플릿 타입 매개변수를 추론을 통해서만 알 수 있기 떄문에
-        // 추론이 불가능하도록 _C를 구성하면 안된다.
-        // 따라서 _C에 (const std::remove_const_t<_C>)는 _C를 추론하기에 알맞지 않으므로 이렇게 작성하는 것은 불가능하다.
-        //template <class _C>
-        //explicit Event(std::shared_ptr<const std::remove_const_t<_C>> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn) { AddListener(pOwner, pConstMemFn); }
-#pragma endregion
-
         /**
-         * @brief 반환값이 존재하는 타입에 대한 함수 호출
+         * @brief 가장 바깥 호출이 끝났을 때 호출 중에 미뤄둔 변경을 한 번에 반영
          * 
-         * @param args 함수 호출에 필요한 매개변수
-         * @return 함수의 반환 값
-        */
-        std::list<_R> operator()(_Args... args) const
-            requires(non_void<_R>)
+         * 추가 대기 중인 리스너들을 목록에 넣고, 호출 중에 복제되어 붙잡아 둔 저장소를 놓고, 만료된 리스너가 많다면 정리한다.\n
+         * 미뤄둔 변경이 없다면 비교 몇 번으로 끝난다.
+         */
+        void FinishDispatch() const
         {
-            std::list<_R> rvs;
-            auto i = m_listeners.begin();
-            while (i != m_listeners.end())
+            if (m_pStorage)
             {
-                try { rvs.push_back((*(*i++))(args...)); }
-                catch (std::bad_weak_ptr e) { i = m_listeners.erase(--i); }
+                if (m_pStorage->pRetired)
+                    m_pStorage->pRetired.reset();
+                if (!m_pStorage->pending.empty())
+                    ApplyPending();
             }
-            return rvs;
+            CompactIfNeeded();
         }
         /**
-         * @brief 반환값이 존재하지 않는 함수 타입에 대한 함수 호출
+         * @brief 추가 대기 중인 리스너들을 우선순위 순서에 맞게 목록에 넣는다.
+         */
+        void ApplyPending() const
+        {
+            Storage &storage = MakeUnique();
+            for (auto &fn : storage.pending)
+                storage.Insert(std::move(fn));
+            storage.pending.clear();
+        }
+        /**
+         * @brief 추가 대기 중인 리스너를 목록에 넣지 않고 등록 해제
          * 
-         * @param args 함수 호출에 필요한 매개변수
+         * @param i pending에서의 위치
+         */
+        void ErasePending(std::size_t i) const
+        {
+            Storage &storage = *m_pStorage;
+            ReleaseSlot(storage.pending[i].GetSlot());
+            storage.pending.erase(storage.pending.begin() + i);
+            for (; i < storage.pending.size(); ++i)
+                storage.slots[storage.pending[i].GetSlot()].index = PendingFlag | static_cast<std::uint32_t>(i);
+        }
+        /**
+         * @brief Dispatch에서 실제로 리스너들을 순회하며 호출
+         * 
+         * 저장소를 다른 복사본과 공유 중이라면 소유 객체가 소멸된 리스너도 만료 표시하지 않고 건너뛰기만 한다.
+         * 공유 중인 저장소는 복사본들이 서로 다른 스레드에서 호출할 수 있으므로 읽기만 해야 하기 때문이다.\n
+         * 리스너 안에서 저장소가 복제될 수 있으므로 매 반복마다 m_pStorage를 다시 읽는다. 복제본은 레코드 위치가 같다.
          */
-        void operator()(_Args... args) const
+        template <class _Call>
+        void DispatchListeners(_Call &&call) const
         {
-            auto i = m_listeners.begin();
-            while (i != m_listeners.end())
+            if (!m_pStorage)
+                return;
+            // 호출 중 등록은 pending에 쌓이고 호출 중 복제된 저장소는 pRetired가 붙잡으므로,
+            // 리스너가 목록을 바꿔도 listeners는 재할당되지 않고 인덱스와 fn 참조가 유효하다.
+            for (std::size_t i = 0; i < m_pStorage->listeners.size(); ++i)
             {
-                try { (*(*i++))(args...); }
-                catch (std::bad_weak_ptr e) { i = m_listeners.erase(--i); }
+                Function &fn = m_pStorage->listeners[i];
+                if (fn.IsExpired())
+                    continue;
+                bool bContinue;
+                if (!fn.HasOwner())
+                    bContinue = call(fn, nullptr);
+                else if (auto pOwner = fn.Lock())
+                    bContinue = call(fn, pOwner.get());
+                else
+                {
+                    if (IsStorageUnique())
+                        ExpireOwner(fn);
+                    continue;
+                }
+                if (!bContinue || Propagation::s_bStopped)
+                    break;
             }
         }
+        template <std::size_t... _Is>
+        void InvokeBatchAoS(std::span<ArgsTuple const> argSets, std::index_sequence<_Is...>) const
+        {
+            if (argSets.empty())
+                return;
+            auto waiters = TakeWaiters(std::get<_Is>(argSets.front())...);
+            DispatchBatch(argSets.size(),
+                [&](Function &fn, void const *pOwner, std::size_t i) { fn(pOwner, std::get<_Is>(argSets[i])...); }, nullptr);
+        }
         /**
-         * @brief 이벤트에 함수 등록
+         * @brief 리스너마다 모든 매개변수 묶음에 대해 호출 (listener-major)
          * 
-         * AddListner와 동일\n
-         * 비멤버 함수에만 사용가능
+         * 리스너가 Propagation::Stop()을 호출하면 그 묶음만 중단 표시하고 나머지 묶음은 계속 호출한다.
+         * 중단 표시용 버퍼는 처음 중단될 때만 할당된다.\n
+         * 벌크 리스너는 중단된 묶음이 없을 때만 callBulk로 한 번에 호출하고, 아니라면 남은 묶음마다 callAt으로 호출한다.
          * 
-         * @param pFn 등록할 함수 포인터
-         * @return Event& 자기 자신을 반환
+         * @param count 매개변수 묶음 수
+         * @param callAt 리스너, 잠근 소유 객체, 묶음 인덱스를 받아 호출하는 함수 객체
+         * @param callBulk 벌크 리스너를 받아 배치 전체로 호출하는 함수 객체, nullptr라면 벌크 리스너도 callAt으로 호출한다.
          */
-        Event& operator+=(EventFnPtr pFn)
+        template <class _CallAt, class _CallBulk>
+        void DispatchBatch(std::size_t count, _CallAt &&callAt, _CallBulk &&callBulk) const
         {
-            if (pFn != nullptr)
-                m_listeners.push_back(std::make_unique<NonMemFunction>(pFn));
-            return *this;
+            std::pmr::vector<char> stopped(m_pResource);
+            std::size_t nStopped = 0;
+            Dispatch([&](Function &fn, void const *pOwner)
+            {
+                if constexpr (!std::is_null_pointer_v<std::remove_cvref_t<_CallBulk>>)
+                {
+                    if (fn.IsBulk() && nStopped == 0)
+                    {
+                        callBulk(fn);
+                        return true;
+                    }
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (nStopped != 0 && stopped[i])
+                        continue;
+                    callAt(fn, pOwner, i);
+                    if (Propagation::s_bStopped)
+                    {
+                        Propagation::s_bStopped = false;
+                        if (stopped.empty())
+                            stopped.resize(count, 0);
+                        stopped[i] = 1;
+                        ++nStopped;
+                    }
+                }
+                return nStopped < count;
+            });
         }
         /**
-         * @brief 이벤트에 등록된 모든 함수를 제거하고 pFn 함수 등록 
+         * @brief 리스너 하나를 호출하고, 리스너별 훅이 설정되어 있다면 걸린 시간을 전달
          * 
-         * @param pFn 등록할 함수 포인
-         * @return Event& 자기 자신을 반환
+         * @param invoke 실제 호출을 수행하고 계속 호출할지 여부를 반환하는 함수 객체
          */
-        Event& operator=(EventFnPtr pFn)
+        template <class _Invoke>
+        bool CallInstrumented(Function const &fn, _Invoke &&invoke) const
         {
-            m_listeners.clear();
-            *this += pFn;
-            return *this;
+            if (!m_instrument.IsListenerHooked())
+                return invoke();
+            // 리스너가 스스로 등록 해제하면 세대 번호가 바뀌므로 호출 전에 핸들을 만든다.
+            ListenerHandle handle = { fn.GetSlot(), m_pStorage->slots[fn.GetSlot()].generation };
+            auto begin = m_instrument.BeginListener();
+            bool bContinue = invoke();
+            m_instrument.EndListener(begin, handle);
+            return bContinue;
         }
         /**
-         * @brief pFn을 이벤트에서 등록 해제
+         * @brief 리스너들을 조각으로 나눠 pool에서 병렬로 호출
          * 
-         * @param pFn 등록 해제할 함수 포인터
-         * @return Event& 자기 자신을 반환
+         * 병렬 호출 중에는 이벤트 상태를 바꾸지 않고, 만료 표시와 정리는 모든 호출이 끝난 뒤 호출한 스레드에서 한다.
+         * 
+         * @param call 리스너 인덱스, 리스너, 잠근 소유 객체를 받아 실제 호출을 수행하는 함수 객체
          */
-        Event& operator-=(EventFnPtr pFn)
+        template <class _Pool, class _Call>
+        void DispatchParallel(_Pool &pool, _Call &&call) const
         {
-            RemoveListener(NonMemFunction(pFn));
-            return *this;
+            DispatchScope scope(*this);
+            if constexpr (_Instrument::Enabled)
+            {
+                auto begin = m_instrument.BeginDispatch();
+                std::size_t nCalled = GetListenerCount();
+                DispatchParallelListeners(pool, [&](std::size_t i, Function &fn, void const *pOwner)
+                {
+                    CallInstrumented(fn, [&] { call(i, fn, pOwner); return true; });
+                });
+                m_instrument.EndDispatch(begin, nCalled);
+            }
+            else
+                DispatchParallelListeners(pool, call);
+        }
+        template <class _Pool, class _Call>
+        void DispatchParallelListeners(_Pool &pool, _Call &&call) const
+        {
+            if (!m_pStorage)
+                return;
+            std::pmr::vector<Function> &listeners = m_pStorage->listeners;
+            std::size_t const count = listeners.size();
+            std::pmr::vector<char> ownerExpired(count, 0, m_pResource);
+            std::mutex errorMutex;
+            std::size_t errorIndex = count;
+            std::exception_ptr pError;
+            pool.ParallelFor(count, 0, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    Function &fn = listeners[i];
+                    if (fn.IsExpired())
+                        continue;
+                    try
+                    {
+                        if (!fn.HasOwner())
+                            call(i, fn, nullptr);
+                        else if (auto pOwner = fn.Lock())
+                            call(i, fn, pOwner.get());
+                        else
+                            ownerExpired[i] = 1;
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock(errorMutex);
+                        if (i < errorIndex)
+                        {
+                            errorIndex = i;
+                            pError = std::current_exception();
+                        }
+                    }
+                }
+            });
+            if (IsStorageUnique())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    if (ownerExpired[i])
+                        ExpireOwner(listeners[i]);
+            }
+            if (pError)
+                std::rethrow_exception(pError);
+        }
+        void RemoveListener(Function const &fn)
+        {
+            if (!m_pStorage)
+                return;
+            for (std::size_t i = 0; i < m_pStorage->listeners.size(); ++i)
+            {
+                Function const &listener = m_pStorage->listeners[i];
+                if (!listener.IsExpired() && listener == fn)
+                {
+                    Expire(MakeUnique().listeners[i]);
+                    return;
+                }
+            }
+            for (std::size_t i = 0; i < m_pStorage->pending.size(); ++i)
+            {
+                if (m_pStorage->pending[i] == fn)
+                {
+                    MakeUnique();
+                    ErasePending(i);
+                    return;
+                }
+            }
+        }
+        ListenerHandle Push(Function &&fn, int priority)
+        {
+            fn.SetPriority(priority);
+            return Push(std::move(fn));
         }
-
         /**
-         * @brief 일반 함수 등록
+         * @brief 새 슬롯을 할당하고 리스너를 우선순위 순서에 맞는 위치에 추가
          * 
-         * @param pFn 등록할 함수 포인터
+         * 호출 중이라면 반복 중인 목록을 바꾸지 않도록 추가 대기 목록에 넣고 가장 바깥 호출이 끝날 때 한 번에 추가한다.
+         * 슬롯은 바로 할당되므로 반환된 핸들로 추가되기 전에도 등록 해제할 수 있다.\n
+         * 객체 참조로 바인딩된 소유 객체가 Trackable이라면 연결을 기록해 소유 객체 소멸 시 등록 해제되도록 한다.
+         * 
+         * @return ListenerHandle 추가된 리스너의 핸들
          */
-        void AddListener(EventFnPtr pFn) { *this += pFn; }
+        ListenerHandle Push(Function &&fn)
+        {
+            if (m_nDispatchDepth == 0)
+                FinishDispatch();
+            Storage &storage = MakeUnique();
+            std::uint32_t slot = storage.freeSlot;
+            if (slot != ListenerHandle::InvalidIndex)
+                storage.freeSlot = storage.slots[slot].index;
+            else
+            {
+                slot = static_cast<std::uint32_t>(storage.slots.size());
+                storage.slots.push_back({});
+            }
+            fn.SetSlot(slot);
+            ListenerHandle handle = { slot, storage.slots[slot].generation };
+            Function *pAdded;
+            if (m_nDispatchDepth != 0)
+            {
+                storage.slots[slot].index = PendingFlag | static_cast<std::uint32_t>(storage.pending.size());
+                pAdded = &storage.pending.emplace_back(std::move(fn));
+            }
+            else
+                pAdded = &storage.listeners[storage.Insert(std::move(fn))];
+            if (Trackable const *pTrackable = pAdded->GetTrackable())
+            {
+                storage.bHasTrackable = true;
+                pTrackable->Track(GetLifetimeToken(), [](void *pEvent, ListenerHandle h) { static_cast<Event *>(pEvent)->RemoveListener(h); }, handle);
+            }
+            return handle;
+        }
         /**
-         * @brief 비상수 객체로부터 비상수 멤버 함수 등록
+         * @brief 만료된 리스너가 전체의 절반을 넘으면 정리
          * 
-         * @param pOwner 비상수 멤버 함수를 호출할 비상수 객체
-         * @param pMemFn 등록할 비상수 멤버 함수
+         * 공유 중인 저장소는 다른 복사본이 읽고 있을 수 있으므로 건드리지 않는다.
          */
-        template <non_constant _C>
-        void AddListener(std::shared_ptr<_C> const &pOwner, EventMemFnPtr<_C> pMemFn)
+        void CompactIfNeeded() const
         {
-            if (pMemFn != nullptr)
-                m_listeners.push_back(std::make_unique<MemFunction<_C>>(pOwner, pMemFn));
+            if (m_pStorage && m_pStorage->nExpired * 2 > m_pStorage->listeners.size() && m_nDispatchDepth == 0 && IsStorageUnique())
+                const_cast<Event *>(this)->Compact();
         }
         /**
-         * @brief 객체로부터 상수 멤버 함수 등록
+         * @brief 저장소를 다른 복사본과 공유하지 않고 있는지 확인
+         */
+        bool IsStorageUnique() const
+        {
+            if (m_pStorage.use_count() != 1)
+                return false;
+            // 다른 복사본이 참조를 놓기 전에 한 읽기가 이후의 쓰기보다 앞서도록 한다.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+        /**
+         * @brief 저장소를 바꾸기 전에 호출해 이 이벤트만 사용하는 저장소로 만든다.
          * 
-         * @param pOwner 상수 멤버 함수를 호출할 객체
-         * @param pConstMemFn 등록할 상수 멤버 함수
+         * 저장소가 없다면 새로 만들고, 다른 복사본과 공유 중이라면 이때 처음으로 만료되지 않은 리스너들을 복제한다.\n
+         * 호출 중이라면 반복이 새 저장소에서 같은 위치로 이어지도록 레코드 배치를 그대로 복제하고,
+         * 지금 호출 중인 레코드가 사라지지 않도록 가장 바깥 호출이 끝날 때까지 기존 저장소를 붙잡아 둔다.
          */
-        template <class _C>
-        void AddListener(std::shared_ptr<_C> const& pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn)
+        Storage &MakeUnique() const
         {
-            if (pConstMemFn != nullptr)
-                m_listeners.push_back(std::make_unique<ConstMemFunction<const _C>>(pOwner, pConstMemFn));
+            if (!m_pStorage)
+                m_pStorage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(m_pResource), m_pResource);
+            else if (!IsStorageUnique())
+            {
+                if (m_nDispatchDepth != 0)
+                    m_pStorage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(m_pResource), *m_pStorage, m_pResource, m_pStorage);
+                else
+                    m_pStorage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(m_pResource), *m_pStorage, m_pResource);
+            }
+            return *m_pStorage;
         }
         /**
-         * @brief 일반 함수 등록 해제
+         * @brief 다른 복사본과 공유 중인 저장소를 리스너를 복제하지 않고 빈 저장소로 바꾼다.
          * 
-         * @param pFn 등록된 함수
+         * 기존 핸들이 새로 등록될 리스너를 가리키지 않도록 슬롯만 옮긴 뒤 사용 중이던 슬롯을 모두 반납한다.\n
+         * 호출 중이라면 지금 호출 중인 레코드가 사라지지 않도록 가장 바깥 호출이 끝날 때까지 기존 저장소를 붙잡아 둔다.
          */
-        void RemoveListener(EventFnPtr pFn) { *this -= pFn; }
+        void ReplaceSharedStorage()
+        {
+            std::shared_ptr<Storage> pOld = std::move(m_pStorage);
+            m_pStorage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(m_pResource), m_pResource);
+            Storage &storage = *m_pStorage;
+            storage.slots = pOld->slots;
+            storage.freeSlot = pOld->freeSlot;
+            for (auto &fn : pOld->listeners)
+                if (!fn.IsExpired())
+                    ReleaseSlot(fn.GetSlot());
+            for (auto &fn : pOld->pending)
+                ReleaseSlot(fn.GetSlot());
+            if (m_nDispatchDepth != 0)
+                storage.pRetired = std::move(pOld);
+        }
         /**
-         * @brief 비상수 객체로 등록된 비상수 멤버 함수 등록 해제
+         * @brief Trackable이 이벤트의 생존 여부와 현재 주소를 확인하기 위한 토큰
          * 
-         * @tparam _C 등록한 비상수 객체 타입
-         * @param _pOwner 등록한 객체
-         * @param pMemFn 등록된 비상수 멤버 함수
+         * Trackable 소유 객체가 처음 바인딩될 때 만들어지며, 이벤트가 이동되면 새 주소로 갱신되고 소멸되면 함께 소멸된다.
          */
-        template <non_constant _C>
-        void RemoveListener(std::shared_ptr<_C> const &_pOwner, EventMemFnPtr<_C> pMemFn)
+        std::weak_ptr<void *> GetLifetimeToken()
         {
-            RemoveListener(MemFunction(_pOwner, pMemFn));
+            if (!m_pLifetime)
+                m_pLifetime = std::allocate_shared<void *>(std::pmr::polymorphic_allocator<void *>(m_pResource), this);
+            return m_pLifetime;
         }
         /**
-         * @brief 객체로 등록된 상수 멤버 함수 등록 해제
+         * @brief 리스너를 만료 표시하고 슬롯을 반납
          * 
-         * @tparam _C 등록한 객체 타입
-         * @param pOwner 등록한 객체
-         * @param pConstMemFn 등록된 상수 멤버 함수
+         * 레코드는 Compact에서 한 번에 제거된다.
          */
-        template <class _C>
-        void RemoveListener(std::shared_ptr<_C> const &pOwner, EventConstMemFnPtr<std::remove_const_t<_C>> pConstMemFn)
+        void Expire(Function &fn) const
         {
-            RemoveListener(ConstMemFunction<const _C>(pOwner, pConstMemFn));
+            fn.MarkExpired();
+            ++m_pStorage->nExpired;
+            ReleaseSlot(fn.GetSlot());
         }
         /**
-         * @brief 등록된 모든 함수들 삭제
+         * @brief 소유 객체가 소멸된 리스너를 만료 표시하고 계측 정책에 알린다.
+         */
+        void ExpireOwner(Function &fn) const
+        {
+            Expire(fn);
+            if constexpr (_Instrument::Enabled)
+                m_instrument.OnPrune(1);
+        }
+        /**
+         * @brief 슬롯의 세대 번호를 올려 기존 핸들을 무효화하고 빈 슬롯 목록에 넣는다.
          */
-        void RemoveAllListener() { m_listeners.clear(); }
+        void ReleaseSlot(std::uint32_t slot) const
+        {
+            Storage &storage = *m_pStorage;
+            ++storage.slots[slot].generation;
+            storage.slots[slot].index = storage.freeSlot;
+            storage.freeSlot = slot;
+        }
 
-    private:
-        void RemoveListener(Function const &fn)
+        /**
+         * @brief 대기 중인 코루틴들을 떼어내 호출 매개변수를 복사해 준다.
+         * 
+         * 반환된 묶음이 소멸될 때 코루틴들이 재개되므로 리스너 호출 전에 받아둔다.\n
+         * 기다리는 코루틴이 없다면 포인터 비교 한 번으로 끝난다.
+         */
+        template <class... _Ts>
+        WaiterBatch TakeWaiters(_Ts const &...args) const
+        {
+            return WaiterBatch(std::exchange(m_pWaiters, nullptr), args...);
+        }
+        /**
+         * @brief o를 기다리던 코루틴들을 이 이벤트의 대기 목록으로 옮긴다.
+         */
+        void SpliceWaiters(Event &o)
+        {
+            if (o.m_pWaiters == nullptr)
+                return;
+            Waiter *pTail = o.m_pWaiters;
+            while (pTail->pNext != nullptr)
+                pTail = pTail->pNext;
+            pTail->pNext = m_pWaiters;
+            if (m_pWaiters != nullptr)
+                m_pWaiters->ppPrevNext = &pTail->pNext;
+            m_pWaiters = std::exchange(o.m_pWaiters, nullptr);
+            m_pWaiters->ppPrevNext = &m_pWaiters;
+        }
+        /**
+         * @brief 핸들이 가리키는 슬롯
+         * 
+         * 사용 중이라면 index는 listeners에서의 위치이고, 비어있다면 다음 빈 슬롯을 가리킨다.
+         */
+        /**
+         * @brief 추가 대기 중인 리스너의 슬롯 index에 붙는 표시, 나머지 비트는 pending에서의 위치이다.
+         */
+        static constexpr std::uint32_t PendingFlag = 0x80000000u;
+        struct Slot
         {
-            auto iter = m_listeners.begin();
-            while (iter != m_listeners.end())
+            std::uint32_t index = ListenerHandle::InvalidIndex;
+            std::uint32_t generation = 0;
+        };
+        /**
+         * @brief 리스너 레코드와 핸들 슬롯을 담는 저장소
+         * 
+         * 이벤트를 복사하면 저장소를 공유하고, 어느 한쪽이 바꾸려 할 때 처음으로 복제한다(copy-on-write).\n
+         * 저장소 자체와 버퍼들은 만든 이벤트의 메모리 리소스에 할당된다.
+         */
+        struct Storage
+        {
+            explicit Storage(std::pmr::memory_resource *pResource) : listeners(pResource), slots(pResource), pending(pResource) {}
+            /**
+             * @brief 만료되지 않은 리스너만 pResource에 복제한다.
+             * 
+             * 슬롯은 그대로 복사하므로 원본의 핸들이 복제본에서도 같은 리스너를 가리킨다.
+             * 추가 대기 중인 리스너는 복제본에서 바로 목록에 들어간다.
+             */
+            Storage(Storage const &o, std::pmr::memory_resource *pResource) : listeners(pResource), slots(o.slots, pResource), pending(pResource), freeSlot(o.freeSlot), bHasTrackable(o.bHasTrackable)
             {
-                if ((*(*iter)) == (fn))
+                listeners.reserve(o.listeners.size() - o.nExpired);
+                for (auto &fn : o.listeners)
                 {
-                    m_listeners.erase(iter);
-                    break;
+                    if (fn.IsExpired())
+                        continue;
+                    slots[fn.GetSlot()].index = static_cast<std::uint32_t>(listeners.size());
+                    listeners.push_back(fn);
                 }
-                ++iter;
+                for (auto &fn : o.pending)
+                    Insert(Function(fn));
             }
-        }
-        mutable std::list<std::unique_ptr<Function>> m_listeners;
+            /**
+             * @brief 호출 중에 레코드 배치를 그대로 pResource에 복제한다.
+             * 
+             * 만료된 레코드와 추가 대기 중인 리스너도 그대로 복사하므로 반복 중인 위치가 복제본에서도 같은 리스너를 가리킨다.
+             * 
+             * @param pRetired 가장 바깥 호출이 끝날 때까지 붙잡아 둘 기존 저장소
+             */
+            Storage(Storage const &o, std::pmr::memory_resource *pResource, std::shared_ptr<Storage> pRetired)
+                : listeners(o.listeners, pResource), slots(o.slots, pResource), pending(o.pending, pResource), freeSlot(o.freeSlot),
+                nExpired(o.nExpired), bHasTrackable(o.bHasTrackable), pRetired(std::move(pRetired)) {}
+
+            /**
+             * @brief 리스너를 우선순위 순서에 맞는 위치에 넣고 슬롯이 그 위치를 가리키게 한다.
+             * 
+             * 같은 우선순위 중에서는 맨 뒤에 들어가므로 등록 순서가 유지된다.
+             * 모든 리스너의 우선순위가 같다면 맨 뒤에 추가하기만 하고, 중간에 끼워 넣을 때만 뒤쪽 리스너들의 슬롯을 갱신한다.
+             * 
+             * @return 추가된 위치
+             */
+            std::size_t Insert(Function &&fn)
+            {
+                std::size_t pos = listeners.size();
+                if (pos != 0 && listeners.back().GetPriority() < fn.GetPriority())
+                {
+                    pos = std::upper_bound(listeners.begin(), listeners.end(), fn.GetPriority(),
+                        [](int priority, Function const &listener) { return priority > listener.GetPriority(); }) - listeners.begin();
+                    listeners.insert(listeners.begin() + pos, std::move(fn));
+                    for (std::size_t i = pos; i < listeners.size(); ++i)
+                        slots[listeners[i].GetSlot()].index = static_cast<std::uint32_t>(i);
+                }
+                else
+                {
+                    slots[fn.GetSlot()].index = static_cast<std::uint32_t>(pos);
+                    listeners.push_back(std::move(fn));
+                }
+                return pos;
+            }
+
+            std::pmr::vector<Function> listeners;
+            std::pmr::vector<Slot> slots;
+            // 호출 중에 추가되어 가장 바깥 호출이 끝나기를 기다리는 리스너들
+            std::pmr::vector<Function> pending;
+            std::uint32_t freeSlot = ListenerHandle::InvalidIndex;
+            std::size_t nExpired = 0;
+            bool bHasTrackable = false;
+            std::shared_ptr<Storage> pRetired;
+        };
+        mutable std::shared_ptr<Storage> m_pStorage;
+        std::shared_ptr<void *> m_pLifetime;
+        std::pmr::memory_resource *m_pResource = std::pmr::get_default_resource();
+        mutable Waiter *m_pWaiters = nullptr;
+        mutable std::uint32_t m_nDispatchDepth = 0;
+        [[no_unique_address]] mutable _Instrument m_instrument;
     };
 }
\ No newline at end of file
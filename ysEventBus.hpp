@@ -0,0 +1,250 @@
+/**
+ * @file ysEventBus.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 페이로드 타입으로 이벤트를 찾아 구독, 발행하는 이벤트 버스
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    /**
+     * @brief 페이로드 타입별 조밀한 ID
+     *
+     * 타입마다 처음 사용될 때 0부터 차례로 하나씩 ID가 매겨지고 프로세스가 끝날 때까지 바뀌지 않는다.\n
+     * ID가 연속적이므로 이벤트 버스는 해시 없이 배열 인덱스로 채널을 찾는다.
+     *
+     * 번역 단위마다 따로 컴파일되는 템플릿으로는 조밀한 ID를 컴파일 시간에 매길 수 없으므로 실행 중에 매긴다. 따라서
+     * - ID는 타입이 처음 사용된 순서에 따라 정해지므로 실행할 때마다 달라질 수 있다. 파일이나 네트워크로 내보내면 안된다.
+     * - 카운터와 타입별 ID는 실행 파일, DLL, 공유 객체마다 따로 있을 수 있다.
+     *   Windows DLL이나 심볼을 숨겨 빌드한 공유 객체는 같은 타입에도 다른 ID를 매기므로, 모듈 경계를 넘어 EventBus를 함께 쓰면 안된다.
+     */
+    class EventTypeId
+    {
+    public:
+        /**
+         * @brief _Payload 타입의 ID
+         *
+         * @tparam _Payload 페이로드 타입, cv 한정자와 참조는 무시한다.
+         */
+        template <class _Payload>
+        static std::size_t Get()
+        {
+            if constexpr (!std::is_same_v<_Payload, std::remove_cvref_t<_Payload>>)
+                return Get<std::remove_cvref_t<_Payload>>();
+            else
+            {
+                static std::size_t const id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+                return id;
+            }
+        }
+        /**
+         * @brief 지금까지 ID가 매겨진 타입 수
+         */
+        static std::size_t GetCount() { return s_nextId.load(std::memory_order_relaxed); }
+
+    private:
+        static inline std::atomic<std::size_t> s_nextId = 0;
+    };
+
+    /**
+     * @brief 페이로드 타입으로 구독, 발행하는 이벤트 버스
+     *
+     * 페이로드 타입마다 Event<void(_Payload const &)> 채널 하나를 두고, EventTypeId로 매겨진 인덱스에 채널을 저장한다.\n
+     * 따라서 발행할 때 채널을 찾는 비용은 배열 접근 한 번이며, 리스너 관리와 호출은 Event를 그대로 사용한다.\n
+     * 채널은 처음 구독하거나 Register할 때 만들어지며, 구독자가 없는 타입을 발행하면 아무 일도 일어나지 않는다.\n
+     * Event와 마찬가지로 스레드 안전하지 않다.
+     *
+     * ex) bus.Subscribe<KeyDown>(OnKeyDown); bus.Publish(KeyDown{ 'A' });
+     */
+    class EventBus
+    {
+        /**
+         * @brief 타입이 지워진 채널을 다루기 위한 연산 테이블
+         */
+        struct ChannelOps
+        {
+            void (*pfnDestroy)(void *pEvent) noexcept;
+            std::size_t (*pfnGetListenerCount)(void const *pEvent);
+            std::size_t (*pfnMemoryUsage)(void const *pEvent);
+        };
+        template <class _Event>
+        static constexpr ChannelOps s_channelOps = {
+            [](void *pEvent) noexcept { delete static_cast<_Event *>(pEvent); },
+            [](void const *pEvent) { return static_cast<_Event const *>(pEvent)->GetListenerCount(); },
+            [](void const *pEvent) { return static_cast<_Event const *>(pEvent)->MemoryUsage(); }
+        };
+        /**
+         * @brief 채널 하나, 만들어지지 않은 타입의 자리는 pEvent가 nullptr이다.
+         */
+        struct Channel
+        {
+            void *pEvent = nullptr;
+            ChannelOps const *pOps = nullptr;
+        };
+
+    public:
+        /**
+         * @brief _Payload 타입의 채널 이벤트 타입
+         */
+        template <class _Payload>
+        using ChannelEvent = Event<void(std::remove_cvref_t<_Payload> const &)>;
+        /**
+         * @brief 채널별 상태
+         */
+        struct ChannelInfo
+        {
+            std::size_t typeId;
+            std::size_t nListener;
+            std::size_t memoryUsage;
+        };
+
+/// @cond
+        EventBus() = default;
+        EventBus(EventBus const &) = delete;
+        EventBus(EventBus &&o) noexcept : m_channels(std::move(o.m_channels)) { o.m_channels.clear(); }
+        ~EventBus() { Clear(); }
+        EventBus& operator=(EventBus const &) = delete;
+        EventBus& operator=(EventBus &&o) noexcept
+        {
+            if (this != &o)
+            {
+                Clear();
+                m_channels = std::move(o.m_channels);
+                o.m_channels.clear();
+            }
+            return *this;
+        }
+/// @endcond
+
+        /**
+         * @brief _Payload 타입의 채널을 미리 만든다.
+         *
+         * @return ChannelEvent<_Payload>& 채널 이벤트
+         */
+        template <class _Payload>
+        ChannelEvent<_Payload>& Register()
+        {
+            using TargetEvent = ChannelEvent<_Payload>;
+            std::size_t id = EventTypeId::Get<_Payload>();
+            if (id >= m_channels.size())
+                m_channels.resize(std::max(id + 1, EventTypeId::GetCount()));
+            Channel &channel = m_channels[id];
+            if (channel.pEvent == nullptr)
+            {
+                channel.pEvent = new TargetEvent();
+                channel.pOps = &s_channelOps<TargetEvent>;
+            }
+            return *static_cast<TargetEvent *>(channel.pEvent);
+        }
+        /**
+         * @brief _Payload 타입의 채널, 아직 만들어지지 않았다면 nullptr
+         */
+        template <class _Payload>
+        ChannelEvent<_Payload> *Find() const
+        {
+            std::size_t id = EventTypeId::Get<_Payload>();
+            if (id >= m_channels.size())
+                return nullptr;
+            return static_cast<ChannelEvent<_Payload> *>(m_channels[id].pEvent);
+        }
+        /**
+         * @brief _Payload 타입 채널에 리스너 등록
+         *
+         * 매개변수는 Event::AddListener에 그대로 전달되므로 함수 포인터, 멤버 함수, 호출 가능한 객체, 우선순위를 모두 사용할 수 있다.
+         *
+         * @param args Event::AddListener에 전달할 매개변수
+         * @return ListenerHandle 등록 해제에 사용할 핸들
+         */
+        template <class _Payload, class... _Ts>
+        ListenerHandle Subscribe(_Ts &&...args)
+        {
+            return Register<_Payload>().AddListener(std::forward<_Ts>(args)...);
+        }
+        /**
+         * @brief _Payload 타입 채널에서 핸들로 리스너 등록 해제
+         *
+         * @param handle Subscribe가 반환한 핸들
+         * @return 리스너가 해제되었는지 여부
+         */
+        template <class _Payload>
+        bool Unsubscribe(ListenerHandle handle)
+        {
+            auto pEvent = Find<_Payload>();
+            return pEvent != nullptr && pEvent->RemoveListener(handle);
+        }
+        /**
+         * @brief payload 타입 채널의 리스너들을 호출
+         *
+         * @param payload 리스너들에게 전달할 페이로드
+         */
+        template <class _Payload>
+        void Publish(_Payload const &payload) const
+        {
+            if (auto pEvent = Find<_Payload>())
+                (*pEvent)(payload);
+        }
+        /**
+         * @brief _Payload 타입 채널에 등록된 리스너 수
+         */
+        template <class _Payload>
+        std::size_t GetListenerCount() const
+        {
+            auto pEvent = Find<_Payload>();
+            return pEvent != nullptr ? pEvent->GetListenerCount() : 0;
+        }
+        /**
+         * @brief _Payload 타입 채널이 사용 중인 메모리 크기(byte), 채널이 없다면 0
+         */
+        template <class _Payload>
+        std::size_t MemoryUsage() const
+        {
+            auto pEvent = Find<_Payload>();
+            return pEvent != nullptr ? pEvent->MemoryUsage() : 0;
+        }
+        /**
+         * @brief 버스와 모든 채널이 사용 중인 메모리 크기(byte)
+         */
+        std::size_t MemoryUsage() const
+        {
+            std::size_t size = sizeof(*this) + m_channels.capacity() * sizeof(Channel);
+            for (auto &channel : m_channels)
+                if (channel.pEvent != nullptr)
+                    size += channel.pOps->pfnMemoryUsage(channel.pEvent);
+            return size;
+        }
+        /**
+         * @brief 만들어진 모든 채널의 ID, 리스너 수, 메모리 사용량
+         */
+        std::vector<ChannelInfo> GetChannelInfos() const
+        {
+            std::vector<ChannelInfo> infos;
+            for (std::size_t id = 0; id < m_channels.size(); ++id)
+            {
+                Channel const &channel = m_channels[id];
+                if (channel.pEvent != nullptr)
+                    infos.push_back({ id, channel.pOps->pfnGetListenerCount(channel.pEvent), channel.pOps->pfnMemoryUsage(channel.pEvent) });
+            }
+            return infos;
+        }
+        /**
+         * @brief 모든 채널 삭제
+         */
+        void Clear()
+        {
+            for (auto &channel : m_channels)
+                if (channel.pEvent != nullptr)
+                    channel.pOps->pfnDestroy(channel.pEvent);
+            m_channels.clear();
+        }
+
+    private:
+        std::vector<Channel> m_channels;
+    };
+}
@@ -0,0 +1,281 @@
+/**
+ * @file ysEventQueue.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 이벤트를 나중에 모아서 호출하기 위한 이벤트 큐
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <bit>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    /**
+     * @brief 이벤트 큐가 가득 찼을 때 Post의 동작
+     */
+    enum class QueueFullPolicy
+    {
+        Block,          ///< 자리가 날 때까지 Post가 기다린다.
+        DropOldest,     ///< 가장 오래된 이벤트를 버리고 새 이벤트를 넣는다.
+        DropNewest      ///< 새 이벤트를 버린다.
+    };
+
+    /**
+     * @brief 이벤트 큐 클래스
+     * 
+     * 이벤트 매개변수들을 미리 할당된 링 버퍼에 담아두었다가 Flush 때 대상 이벤트로 한 번에 호출한다.\n
+     * 링 버퍼는 여러 스레드가 동시에 Post할 수 있는 잠금 없는 큐(Vyukov bounded MPMC queue)로,
+     * Post는 위치 CAS 한 번과 매개변수 복사, 순번 저장만 수행한다.\n
+     * 호출할 시점에는 반환 값을 받을 호출자가 없으므로 반환 타입이 void인 이벤트만 사용할 수 있다.\n
+     * 리스너 안에서 같은 큐에 Post할 수 있으며, 그 이벤트는 다음 Flush에서 호출된다.
+     * 리스너 안에서 부른 Flush는 아무 일도 하지 않고, 큐가 가득 찼을 때의 Post는 Block 정책이라도 기다리지 않고 새 이벤트를 버린다.
+     * 
+     * @tparam _FuncType 함수의 타입
+     * @tparam _Event 실제로 호출할 이벤트 템플릿, 작업 스레드를 쓰면서 다른 스레드에서 리스너를 바꾼다면 ConcurrentEvent를 사용한다.
+     */
+    template <typename _FuncType, template <typename...> class _Event = Event>
+    class EventQueue;
+
+    template <typename... _Args, template <typename...> class _Event>
+    class EventQueue<void(_Args...), _Event>
+    {
+        using TargetEvent = _Event<void(_Args...)>;
+        using Payload = std::tuple<std::decay_t<_Args>...>;
+        /**
+         * @brief 링 버퍼의 한 칸
+         * 
+         * sequence로 해당 칸이 쓰기 가능한지, 읽기 가능한지를 판단한다.
+         */
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            alignas(Payload) std::byte storage[sizeof(Payload)];
+        };
+
+    public:
+        /**
+         * @brief 이벤트 큐 생성
+         * 
+         * @param event Flush 때 호출할 이벤트, 큐보다 오래 살아있어야 한다.
+         * @param capacity 링 버퍼 크기, 2의 거듭제곱으로 올림된다.
+         * @param policy 큐가 가득 찼을 때 Post의 동작
+         */
+        EventQueue(TargetEvent &event, std::size_t capacity, QueueFullPolicy policy = QueueFullPolicy::Block)
+            : m_event(event), m_policy(policy), m_mask(std::bit_ceil(capacity < 2 ? 2 : capacity) - 1), m_pCells(new Cell[m_mask + 1])
+        {
+            for (std::size_t i = 0; i <= m_mask; ++i)
+                m_pCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        EventQueue(EventQueue const &) = delete;
+        ~EventQueue()
+        {
+            StopWorker();
+            while (Cell *pCell = TryPop())
+                Release(*pCell);
+        }
+        EventQueue& operator=(EventQueue const &) = delete;
+
+        /**
+         * @brief 이벤트를 큐에 넣는다.
+         * 
+         * 여러 스레드에서 동시에 호출할 수 있다.\n
+         * Block 정책에서 큐가 가득 찼다면 Flush나 작업 스레드가 자리를 비울 때까지 기다린다.
+         * 단, 이 큐를 Flush하는 중인 리스너 안이라면 기다리는 동안 자리가 날 수 없으므로 DropNewest처럼 버린다.
+         * 
+         * @param args 나중에 호출할 때 사용할 매개변수
+         * @return 새 이벤트가 큐에 들어갔는지 여부, DropNewest 정책이나 Flush 중인 리스너 안에서 큐가 가득 찼다면 false
+         */
+        bool Post(EventArg<_Args>... args)
+        {
+            while (!TryPush(std::forward<EventArg<_Args>>(args)...))
+            {
+                QueueFullPolicy policy = m_policy;
+                if (policy == QueueFullPolicy::Block && m_flushing.IsCurrent())
+                    policy = QueueFullPolicy::DropNewest;
+                switch (policy)
+                {
+                case QueueFullPolicy::Block:
+                    std::this_thread::yield();
+                    break;
+                case QueueFullPolicy::DropOldest:
+                    if (Cell *pCell = TryPop())
+                    {
+                        Release(*pCell);
+                        m_nDropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case QueueFullPolicy::DropNewest:
+                    m_nDropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            // 작업 스레드가 잠들려는 중이라면 깨운다. (Dekker 패턴이므로 seq_cst 펜스가 필요하다)
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_bWorkerSleeping.load(std::memory_order_relaxed))
+            {
+                m_wakeSignal.fetch_add(1, std::memory_order_relaxed);
+                m_wakeSignal.notify_one();
+            }
+            return true;
+        }
+        /**
+         * @brief 큐에 쌓인 이벤트들을 호출한 스레드에서 순서대로 호출
+         * 
+         * 한 번에 최대 링 버퍼 크기만큼 호출하므로 Post가 계속 들어와도 끝없이 돌지 않는다.\n
+         * 이 큐를 Flush하는 중인 리스너 안에서 호출하면 아무 일도 하지 않는다.
+         * 
+         * @return 호출한 이벤트 수
+         */
+        std::size_t Flush()
+        {
+            if (m_flushing.IsCurrent())
+                return 0;
+            std::lock_guard lock(m_flushMutex);
+            FlushingThread::Scope scope(m_flushing);
+            std::size_t n = 0;
+            Cell *pCell;
+            while (n <= m_mask && (pCell = TryPop()) != nullptr)
+            {
+                std::apply([this](auto &...args) { m_event(args...); }, GetPayload(*pCell));
+                Release(*pCell);
+                ++n;
+            }
+            return n;
+        }
+        /**
+         * @brief 큐가 빌 때마다 잠들었다가 Post가 들어오면 Flush하는 작업 스레드 시작
+         */
+        void StartWorker()
+        {
+            if (m_worker.joinable())
+                return;
+            m_bStopWorker.store(false, std::memory_order_relaxed);
+            m_worker = std::thread([this]() { WorkerLoop(); });
+        }
+        /**
+         * @brief 남은 이벤트를 모두 호출한 뒤 작업 스레드 종료
+         */
+        void StopWorker()
+        {
+            if (!m_worker.joinable())
+                return;
+            m_bStopWorker.store(true, std::memory_order_seq_cst);
+            m_wakeSignal.fetch_add(1, std::memory_order_relaxed);
+            m_wakeSignal.notify_one();
+            m_worker.join();
+        }
+        /**
+         * @brief 큐가 가득 차서 버려진 이벤트 수
+         */
+        std::size_t GetDroppedCount() const { return m_nDropped.load(std::memory_order_relaxed); }
+        /**
+         * @brief 링 버퍼 크기
+         */
+        std::size_t GetCapacity() const { return m_mask + 1; }
+
+    private:
+        bool TryPush(EventArg<_Args>... args)
+        {
+            std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = m_pCells[pos & m_mask];
+                std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        ::new (cell.storage) Payload(std::forward<EventArg<_Args>>(args)...);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        /**
+         * @brief 가장 오래된 칸을 꺼낸다.
+         * 
+         * 다 사용한 뒤 반드시 Release로 칸을 돌려줘야 한다.
+         * 
+         * @return 꺼낸 칸, 큐가 비어있다면 nullptr
+         */
+        Cell *TryPop()
+        {
+            std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = m_pCells[pos & m_mask];
+                std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &cell;
+                }
+                else if (diff < 0)
+                    return nullptr;
+                else
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        static Payload &GetPayload(Cell &cell) { return *std::launder(reinterpret_cast<Payload *>(cell.storage)); }
+        /**
+         * @brief 꺼낸 칸의 매개변수를 소멸시키고 다음 바퀴의 Post가 쓸 수 있도록 돌려준다.
+         */
+        void Release(Cell &cell)
+        {
+            std::size_t seq = cell.sequence.load(std::memory_order_relaxed);
+            GetPayload(cell).~Payload();
+            cell.sequence.store(seq + m_mask, std::memory_order_release);
+        }
+        bool IsEmpty() const
+        {
+            std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            return m_pCells[pos & m_mask].sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+        void WorkerLoop()
+        {
+            for (;;)
+            {
+                Flush();
+                if (m_bStopWorker.load(std::memory_order_seq_cst))
+                {
+                    if (IsEmpty())
+                        return;
+                    continue;
+                }
+                auto signal = m_wakeSignal.load(std::memory_order_relaxed);
+                m_bWorkerSleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (IsEmpty() && !m_bStopWorker.load(std::memory_order_seq_cst))
+                    m_wakeSignal.wait(signal, std::memory_order_relaxed);
+                m_bWorkerSleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        TargetEvent &m_event;
+        QueueFullPolicy m_policy;
+        std::size_t m_mask;
+        std::unique_ptr<Cell[]> m_pCells;
+        alignas(64) std::atomic<std::size_t> m_enqueuePos = 0;
+        alignas(64) std::atomic<std::size_t> m_dequeuePos = 0;
+        alignas(64) std::atomic<std::size_t> m_nDropped = 0;
+        std::atomic<bool> m_bWorkerSleeping = false;
+        std::atomic<bool> m_bStopWorker = false;
+        std::atomic<std::uint32_t> m_wakeSignal = 0;
+        std::mutex m_flushMutex;
+        FlushingThread m_flushing;
+        std::thread m_worker;
+    };
+}
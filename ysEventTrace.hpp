@@ -0,0 +1,770 @@
+/**
+ * @file ysEventTrace.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 이벤트 호출을 바이너리 로그로 기록하고 메모리 매핑으로 다시 재생하는 트레이스
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <memory>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+#include "ysEvent.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace YS
+{
+#pragma region Serializer
+    /**
+     * @brief 트레이스 레코드에 매개변수 하나를 기록하고 읽는 방법
+     *
+     * 기본으로 자명하게 복사 가능한 타입, basic_string, basic_string_view, 자명하게 복사 가능한 원소의 vector를 지원한다.
+     * 자명하게 복사 가능한 타입은 기본 생성자가 없어도 된다.\n
+     * 포인터와 멤버 포인터는 재생하는 프로세스에서 의미가 없으므로 기본으로 지원하지 않는다.
+     * char const *처럼 가리키는 값을 기록하려면 직접 특수화한다.
+     * ex) template <> struct YS::TraceSerializer<char const *> : YS::TraceSerializer<std::string_view> {};\n
+     * 다른 타입은 아래 세 정적 함수를 가진 특수화를 추가한다.
+     * - std::size_t Size(_T const &value) : 기록할 바이트 수
+     * - std::byte *Write(std::byte *p, _T const &value) : p에 기록하고 기록한 다음 위치를 반환
+     * - _T Read(std::byte const *&p) : p에서 읽고 p를 읽은 다음 위치로 옮긴다.
+     *
+     * 기록은 같은 기계에서 재생하는 것을 전제로 하므로 바이트 순서를 바꾸지 않는다.
+     *
+     * @tparam _T 매개변수 타입, cv 한정자와 참조를 뗀 타입
+     */
+    template <class _T>
+    struct TraceSerializer;
+
+    template <class _T>
+        requires(std::is_trivially_copyable_v<_T> && !std::is_pointer_v<_T> && !std::is_member_pointer_v<_T>)
+    struct TraceSerializer<_T>
+    {
+        static std::size_t Size(_T const &) { return sizeof(_T); }
+        static std::byte *Write(std::byte *p, _T const &value)
+        {
+            std::memcpy(p, std::addressof(value), sizeof(_T));
+            return p + sizeof(_T);
+        }
+        static _T Read(std::byte const *&p)
+        {
+            // 로그 안의 위치는 _T 정렬에 맞지 않을 수 있으므로 정렬된 버퍼로 옮겨 비트 그대로 만든다.
+            alignas(_T) std::byte buffer[sizeof(_T)];
+            std::memcpy(buffer, p, sizeof(_T));
+            p += sizeof(_T);
+            return std::bit_cast<_T>(buffer);
+        }
+    };
+    /**
+     * @brief 원소 수(uint32) 뒤에 원소들을 그대로 기록하는 연속 컨테이너 직렬화
+     */
+    template <class _C, class _T>
+    struct TraceSpanSerializer
+    {
+        static std::size_t Size(_C const &value) { return sizeof(std::uint32_t) + value.size() * sizeof(_T); }
+        static std::byte *Write(std::byte *p, _C const &value)
+        {
+            std::uint32_t count = static_cast<std::uint32_t>(value.size());
+            std::memcpy(p, &count, sizeof(count));
+            p += sizeof(count);
+            if (count != 0)
+                std::memcpy(p, value.data(), count * sizeof(_T));
+            return p + count * sizeof(_T);
+        }
+        static std::pair<_T const *, std::uint32_t> ReadSpan(std::byte const *&p)
+        {
+            std::uint32_t count;
+            std::memcpy(&count, p, sizeof(count));
+            auto pData = reinterpret_cast<_T const *>(p + sizeof(count));
+            p += sizeof(count) + count * sizeof(_T);
+            return { pData, count };
+        }
+    };
+    template <class _Char, class _Traits, class _Alloc>
+    struct TraceSerializer<std::basic_string<_Char, _Traits, _Alloc>> : TraceSpanSerializer<std::basic_string<_Char, _Traits, _Alloc>, _Char>
+    {
+        static std::basic_string<_Char, _Traits, _Alloc> Read(std::byte const *&p)
+        {
+            auto [pData, count] = TraceSerializer::ReadSpan(p);
+            std::basic_string<_Char, _Traits, _Alloc> value(count, _Char());
+            std::memcpy(value.data(), pData, count * sizeof(_Char));
+            return value;
+        }
+    };
+    /**
+     * @brief 재생할 때는 매핑된 로그를 직접 가리키므로 복사가 일어나지 않는다.
+     *
+     * 로그의 문자 위치가 _Char 정렬에 맞지 않을 수 있으므로 char 계열에만 사용한다.
+     */
+    template <class _Char, class _Traits>
+        requires(sizeof(_Char) == 1)
+    struct TraceSerializer<std::basic_string_view<_Char, _Traits>> : TraceSpanSerializer<std::basic_string_view<_Char, _Traits>, _Char>
+    {
+        static std::basic_string_view<_Char, _Traits> Read(std::byte const *&p)
+        {
+            auto [pData, count] = TraceSerializer::ReadSpan(p);
+            return { pData, count };
+        }
+    };
+    template <class _T, class _Alloc>
+        requires(std::is_trivially_copyable_v<_T> && !std::is_pointer_v<_T> && !std::is_member_pointer_v<_T>)
+    struct TraceSerializer<std::vector<_T, _Alloc>> : TraceSpanSerializer<std::vector<_T, _Alloc>, _T>
+    {
+        static std::vector<_T, _Alloc> Read(std::byte const *&p)
+        {
+            auto [pData, count] = TraceSerializer::ReadSpan(p);
+            auto pElement = reinterpret_cast<std::byte const *>(pData);
+            std::vector<_T, _Alloc> value;
+            value.reserve(count);
+            for (std::uint32_t i = 0; i < count; ++i)
+                value.push_back(TraceSerializer<_T>::Read(pElement));
+            return value;
+        }
+    };
+#pragma endregion
+
+#pragma region Format
+    /**
+     * @brief 트레이스 파일 머리
+     */
+    struct TraceFileHeader
+    {
+        static constexpr char Magic[8] = { 'Y', 'S', 'T', 'R', 'A', 'C', 'E', '\0' };
+        static constexpr std::uint32_t CurrentVersion = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t reserved;
+    };
+    /**
+     * @brief 레코드 머리, 바로 뒤에 size 바이트의 직렬화된 매개변수가 이어진다.
+     *
+     * 레코드는 정렬 없이 빈틈없이 이어지므로 memcpy로 읽어야 한다.
+     */
+    struct TraceRecordHeader
+    {
+        std::uint64_t timestamp;    ///< 기록 시작부터 지난 시간(ns)
+        std::uint32_t eventId;
+        std::uint32_t size;
+    };
+#pragma endregion
+
+    /**
+     * @brief 이벤트 호출을 덧붙이기만 하는 바이너리 로그로 기록하는 트레이스 기록기
+     *
+     * 스레드마다 청크 버퍼를 하나씩 두고 레코드를 이어 쓰므로, 기록 중에는 잠금도 원자적 읽기-수정-쓰기도 일어나지 않는다.\n
+     * 청크가 가득 차면 잠금 없는 목록에 넘기고 새 청크를 할당하며, Flush가 넘겨진 청크들을 파일에 쓴다.\n
+     * 따라서 기록 비용은 시간 측정 한 번과 매개변수 복사이며, 파일 쓰기는 Flush를 부르는 스레드(프레임 끝, 전용 스레드 등)가 맡는다.
+     *
+     * 파일 안의 레코드는 스레드별 청크 단위로 섞여 있으므로 스레드 사이의 순서는 타임스탬프로만 알 수 있다. TraceReplayer는 타임스탬프 순으로 재생한다.
+     *
+     * ex) TraceRecorder recorder; recorder.Open("frame.trace"); recorder.Attach(damaged, 1); ... recorder.Close();
+     */
+    class TraceRecorder
+    {
+        /**
+         * @brief 레코드를 이어 쓰는 버퍼 한 덩어리, 바로 뒤에 capacity 바이트가 이어진다.
+         */
+        struct ThreadBuffer;
+        struct Chunk
+        {
+            Chunk *pNext;
+            ThreadBuffer *pOwner;
+            std::size_t used;
+            std::size_t capacity;
+
+            std::byte *GetData() { return reinterpret_cast<std::byte *>(this + 1); }
+            static void DeleteList(Chunk *pChunk)
+            {
+                while (pChunk != nullptr)
+                    ::operator delete(std::exchange(pChunk, pChunk->pNext));
+            }
+        };
+        /**
+         * @brief 스레드 하나가 쓰는 버퍼, 기록하는 스레드만 쓰고 통계는 다른 스레드에서 읽는다.
+         *
+         * 파일에 쓴 기본 크기 청크는 pReturned로 돌려받아 다시 쓰므로, 기록이 이어지는 동안에는 할당과 새 페이지 접근이 일어나지 않는다.
+         */
+        struct ThreadBuffer
+        {
+            std::thread::id threadId;
+            Chunk *pChunk = nullptr;
+            Chunk *pSpare = nullptr;
+            std::atomic<Chunk *> pReturned = nullptr;
+            std::atomic<std::uint64_t> nRecord = 0;
+            std::atomic<std::uint64_t> nByte = 0;
+
+            ~ThreadBuffer()
+            {
+                Chunk::DeleteList(pChunk);
+                Chunk::DeleteList(pSpare);
+                Chunk::DeleteList(pReturned.load(std::memory_order_acquire));
+            }
+        };
+        /**
+         * @brief 스레드가 최근에 사용한 기록기들의 버퍼
+         *
+         * 한 스레드가 여러 기록기에 번갈아 기록해도 잠그지 않도록 최근에 쓴 순서대로 Capacity개까지 기억한다.\n
+         * 기록기마다, Open할 때마다 새 ID를 받으므로 소멸되었거나 다시 열린 기록기의 버퍼를 잘못 쓰지 않는다.
+         */
+        struct ThreadCache
+        {
+            struct Entry
+            {
+                std::uint64_t recorderId = 0;
+                ThreadBuffer *pBuffer = nullptr;
+            };
+            static constexpr std::size_t Capacity = 4;
+
+            ThreadBuffer *Find(std::uint64_t recorderId)
+            {
+                if (entries[0].recorderId == recorderId)
+                    return entries[0].pBuffer;
+                for (std::size_t i = 1; i < Capacity; ++i)
+                {
+                    if (entries[i].recorderId == recorderId)
+                    {
+                        std::rotate(entries, entries + i, entries + i + 1);
+                        return entries[0].pBuffer;
+                    }
+                }
+                return nullptr;
+            }
+            /**
+             * @brief 맨 앞에 넣고, 가득 찼다면 가장 오래 쓰지 않은 기록기를 잊는다.
+             */
+            void Insert(std::uint64_t recorderId, ThreadBuffer *pBuffer)
+            {
+                std::move_backward(entries, entries + Capacity - 1, entries + Capacity);
+                entries[0] = { recorderId, pBuffer };
+            }
+
+            Entry entries[Capacity];
+        };
+
+    public:
+        using Clock = std::chrono::steady_clock;
+        /**
+         * @brief 청크 기본 크기(byte), 이보다 큰 레코드는 그 크기의 청크를 따로 할당한다.
+         */
+        static constexpr std::size_t ChunkSize = 64 * 1024;
+
+/// @cond
+        TraceRecorder() = default;
+        TraceRecorder(TraceRecorder const &) = delete;
+        ~TraceRecorder() { Close(); }
+        TraceRecorder& operator=(TraceRecorder const &) = delete;
+/// @endcond
+
+        /**
+         * @brief path에 새 로그를 만들고 기록 시작
+         *
+         * 이미 열려 있다면 먼저 Close한다. 레코드의 타임스탬프는 Open한 시점부터 잰다.
+         *
+         * @return 파일을 열었는지 여부
+         */
+        bool Open(char const *path)
+        {
+            Close();
+            std::lock_guard lock(m_mutex);
+            m_file.open(path, std::ios::binary | std::ios::trunc);
+            if (!m_file)
+                return false;
+            TraceFileHeader header{};
+            std::memcpy(header.magic, TraceFileHeader::Magic, sizeof(header.magic));
+            header.version = TraceFileHeader::CurrentVersion;
+            m_file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+            m_nWritten = sizeof(header);
+            m_nClosedRecord = m_nClosedByte = 0;
+            m_start = Clock::now();
+            m_id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+            m_bOpen.store(true, std::memory_order_release);
+            return true;
+        }
+        /**
+         * @brief 남은 레코드를 모두 쓰고 로그를 닫는다.
+         *
+         * 스레드별 버퍼의 쓰다 만 청크까지 쓰므로 다른 스레드가 Record하는 중에 호출하면 안된다.
+         */
+        void Close()
+        {
+            if (!m_bOpen.exchange(false, std::memory_order_acq_rel))
+                return;
+            std::lock_guard lock(m_mutex);
+            WriteFullChunks();
+            for (auto &pBuffer : m_buffers)
+            {
+                if (pBuffer->pChunk != nullptr)
+                    WriteChunk(std::exchange(pBuffer->pChunk, nullptr));
+                m_nClosedRecord += pBuffer->nRecord.load(std::memory_order_relaxed);
+                m_nClosedByte += pBuffer->nByte.load(std::memory_order_relaxed);
+            }
+            m_buffers.clear();
+            m_file.close();
+        }
+        /**
+         * @brief 가득 찬 청크들을 파일에 쓴다.
+         *
+         * 다른 스레드가 Record하는 중에도 호출할 수 있다.
+         *
+         * @return 지금까지 파일에 쓴 바이트 수
+         */
+        std::uint64_t Flush()
+        {
+            std::lock_guard lock(m_mutex);
+            WriteFullChunks();
+            m_file.flush();
+            return m_nWritten;
+        }
+        /**
+         * @brief 레코드 하나를 호출한 스레드의 버퍼에 기록
+         *
+         * 열려 있지 않다면 아무 일도 일어나지 않는다.
+         *
+         * @param eventId 재생할 때 이벤트를 찾을 ID, TraceReplayer가 배열 인덱스로 쓰므로 작은 정수를 사용한다.
+         * @param args 기록할 매개변수, TraceSerializer로 직렬화한다.
+         */
+        template <class... _Ts>
+        void Record(std::uint32_t eventId, _Ts const &...args)
+        {
+            // Open이 뮤텍스 안에서 쓴 m_start, m_id를 읽으므로 acquire로 Open의 release와 짝을 맞춘다.
+            if (!m_bOpen.load(std::memory_order_acquire))
+                return;
+            std::size_t size = (std::size_t(0) + ... + TraceSerializer<_Ts>::Size(args));
+            ThreadBuffer &buffer = GetThreadBuffer();
+            std::size_t recordSize = sizeof(TraceRecordHeader) + size;
+            Chunk *pChunk = buffer.pChunk;
+            if (pChunk == nullptr || pChunk->capacity - pChunk->used < recordSize)
+                pChunk = NextChunk(buffer, recordSize);
+            std::byte *p = pChunk->GetData() + pChunk->used;
+            TraceRecordHeader header{ static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count()),
+                eventId, static_cast<std::uint32_t>(size) };
+            std::memcpy(p, &header, sizeof(header));
+            p += sizeof(header);
+            ((p = TraceSerializer<_Ts>::Write(p, args)), ...);
+            pChunk->used += recordSize;
+            buffer.nRecord.store(buffer.nRecord.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            buffer.nByte.store(buffer.nByte.load(std::memory_order_relaxed) + recordSize, std::memory_order_relaxed);
+        }
+        /**
+         * @brief event의 모든 호출을 eventId로 기록하는 리스너 등록
+         *
+         * 가장 높은 우선순위로 등록되므로 다른 리스너가 전파를 멈춰도 기록된다.\n
+         * 반환 값이 있는 이벤트는 리스너로 끼어들면 호출 결과가 바뀌므로, 호출하는 쪽에서 Record를 직접 부른다.
+         *
+         * @return ListenerHandle 기록을 멈출 때 event.RemoveListener에 사용할 핸들
+         */
+        template <typename... _Args, class _Instrument>
+        ListenerHandle Attach(Event<void(_Args...), _Instrument> &event, std::uint32_t eventId)
+        {
+            return event.AddListener([this, eventId](EventArg<_Args>... args) { Record(eventId, args...); }, std::numeric_limits<int>::max());
+        }
+        bool IsOpen() const { return m_bOpen.load(std::memory_order_acquire); }
+        /**
+         * @brief 지금까지 기록된 레코드 수
+         */
+        std::uint64_t GetRecordCount() const
+        {
+            std::lock_guard lock(m_mutex);
+            std::uint64_t count = m_nClosedRecord;
+            for (auto &pBuffer : m_buffers)
+                count += pBuffer->nRecord.load(std::memory_order_relaxed);
+            return count;
+        }
+        /**
+         * @brief 지금까지 기록된 레코드들의 바이트 수, 레코드 머리를 포함한다.
+         */
+        std::uint64_t GetByteCount() const
+        {
+            std::lock_guard lock(m_mutex);
+            std::uint64_t size = m_nClosedByte;
+            for (auto &pBuffer : m_buffers)
+                size += pBuffer->nByte.load(std::memory_order_relaxed);
+            return size;
+        }
+
+    private:
+        /**
+         * @brief 호출한 스레드의 버퍼, Record가 m_bOpen을 acquire로 읽은 뒤에만 호출한다.
+         */
+        ThreadBuffer &GetThreadBuffer()
+        {
+            static thread_local ThreadCache t_cache;
+            if (ThreadBuffer *pBuffer = t_cache.Find(m_id))
+                return *pBuffer;
+            std::lock_guard lock(m_mutex);
+            auto threadId = std::this_thread::get_id();
+            auto it = std::find_if(m_buffers.begin(), m_buffers.end(), [&](auto const &pBuffer) { return pBuffer->threadId == threadId; });
+            if (it == m_buffers.end())
+            {
+                it = m_buffers.insert(m_buffers.end(), std::make_unique<ThreadBuffer>());
+                (*it)->threadId = threadId;
+            }
+            t_cache.Insert(m_id, it->get());
+            return **it;
+        }
+        /**
+         * @brief 쓰던 청크를 가득 찬 청크 목록에 넘기고 recordSize가 들어갈 새 청크를 할당
+         */
+        Chunk *NextChunk(ThreadBuffer &buffer, std::size_t recordSize)
+        {
+            if (Chunk *pFull = buffer.pChunk)
+            {
+                pFull->pNext = m_pFullChunks.load(std::memory_order_relaxed);
+                while (!m_pFullChunks.compare_exchange_weak(pFull->pNext, pFull, std::memory_order_release, std::memory_order_relaxed));
+            }
+            if (buffer.pSpare == nullptr)
+                buffer.pSpare = buffer.pReturned.exchange(nullptr, std::memory_order_acquire);
+            Chunk *pChunk;
+            if (recordSize <= ChunkSize && buffer.pSpare != nullptr)
+                pChunk = std::exchange(buffer.pSpare, buffer.pSpare->pNext);
+            else
+            {
+                std::size_t capacity = std::max(ChunkSize, recordSize);
+                pChunk = static_cast<Chunk *>(::operator new(sizeof(Chunk) + capacity));
+                pChunk->pOwner = &buffer;
+                pChunk->capacity = capacity;
+            }
+            pChunk->pNext = nullptr;
+            pChunk->used = 0;
+            buffer.pChunk = pChunk;
+            return pChunk;
+        }
+        void WriteFullChunks()
+        {
+            // 목록은 넘겨진 역순이므로 뒤집어서 스레드별 기록 순서대로 쓴다.
+            Chunk *pChunk = m_pFullChunks.exchange(nullptr, std::memory_order_acquire);
+            Chunk *pReversed = nullptr;
+            while (pChunk != nullptr)
+            {
+                Chunk *pNext = pChunk->pNext;
+                pChunk->pNext = pReversed;
+                pReversed = pChunk;
+                pChunk = pNext;
+            }
+            while (pReversed != nullptr)
+                WriteChunk(std::exchange(pReversed, pReversed->pNext));
+        }
+        void WriteChunk(Chunk *pChunk)
+        {
+            m_file.write(reinterpret_cast<char const *>(pChunk->GetData()), static_cast<std::streamsize>(pChunk->used));
+            m_nWritten += pChunk->used;
+            if (pChunk->capacity != ChunkSize)
+            {
+                ::operator delete(pChunk);
+                return;
+            }
+            // 쓴 청크를 주인 스레드에 돌려준다. 주인은 목록을 통째로 가져가므로 ABA 문제가 없다.
+            ThreadBuffer &owner = *pChunk->pOwner;
+            pChunk->pNext = owner.pReturned.load(std::memory_order_relaxed);
+            while (!owner.pReturned.compare_exchange_weak(pChunk->pNext, pChunk, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        static inline std::atomic<std::uint64_t> s_nextId = 1;
+
+        std::atomic<bool> m_bOpen = false;
+        std::uint64_t m_id = 0;
+        Clock::time_point m_start;
+        std::atomic<Chunk *> m_pFullChunks = nullptr;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+        std::ofstream m_file;
+        std::uint64_t m_nWritten = 0;
+        std::uint64_t m_nClosedRecord = 0;
+        std::uint64_t m_nClosedByte = 0;
+    };
+
+    /**
+     * @brief TraceReplayer::Replay의 재생 속도
+     */
+    enum class ReplayMode
+    {
+        AsFastAsPossible,   ///< 기다리지 않고 연달아 호출한다.
+        RecordedSpeed       ///< 기록된 시간 간격을 지켜 호출한다.
+    };
+
+    /**
+     * @brief 재생 결과
+     */
+    struct ReplayReport
+    {
+        std::uint64_t nRecord = 0;          ///< 호출한 레코드 수
+        std::uint64_t nSkipped = 0;         ///< 바인딩된 이벤트가 없어 건너뛴 레코드 수
+        std::uint64_t nByte = 0;            ///< 호출한 레코드들의 바이트 수, 레코드 머리를 포함한다.
+        std::chrono::nanoseconds elapsed{};             ///< 재생에 걸린 시간
+        std::chrono::nanoseconds recordedDuration{};    ///< 첫 레코드부터 마지막 레코드까지 기록된 시간
+        std::vector<std::uint64_t> fireCounts;          ///< 이벤트 ID별 호출 수
+
+        double GetEventsPerSecond() const { return elapsed.count() > 0 ? static_cast<double>(nRecord) * 1e9 / static_cast<double>(elapsed.count()) : 0.0; }
+        double GetBytesPerSecond() const { return elapsed.count() > 0 ? static_cast<double>(nByte) * 1e9 / static_cast<double>(elapsed.count()) : 0.0; }
+        /**
+         * @brief 레코드 하나를 디코딩하고 호출하는 데 걸린 평균 시간(ns)
+         */
+        double GetNsPerEvent() const { return nRecord > 0 ? static_cast<double>(elapsed.count()) / static_cast<double>(nRecord) : 0.0; }
+    };
+
+    /**
+     * @brief TraceRecorder가 기록한 로그를 메모리 매핑해 새 이벤트들로 다시 호출하는 재생기
+     *
+     * Open할 때 로그 전체를 읽기 전용으로 매핑하고 레코드 위치를 타임스탬프 순으로 정렬한 색인을 만든다.\n
+     * 재생할 때는 매핑된 메모리에서 매개변수를 바로 디코딩해 Bind한 이벤트를 호출하므로 파일 읽기가 끼어들지 않는다.\n
+     * 마지막 레코드가 잘려 있다면(기록 중 비정상 종료 등) 그 레코드부터 무시한다.
+     *
+     * ex) TraceReplayer replayer; replayer.Open("frame.trace"); replayer.Bind(1, damaged); auto report = replayer.Replay();
+     */
+    class TraceReplayer
+    {
+        /**
+         * @brief 이벤트 ID 하나에 바인딩된 이벤트와 디코딩 함수
+         */
+        struct Binding
+        {
+            void (*pfnFire)(void *pEvent, std::byte const *pPayload) = nullptr;
+            void *pEvent = nullptr;
+        };
+        struct IndexEntry
+        {
+            std::uint64_t timestamp;
+            std::size_t offset;
+        };
+
+    public:
+/// @cond
+        TraceReplayer() = default;
+        TraceReplayer(TraceReplayer const &) = delete;
+        ~TraceReplayer() { Close(); }
+        TraceReplayer& operator=(TraceReplayer const &) = delete;
+/// @endcond
+
+        /**
+         * @brief path의 로그를 매핑하고 색인을 만든다.
+         *
+         * 이미 열려 있다면 먼저 Close한다. Bind는 유지된다.
+         *
+         * @return 파일을 매핑했고 머리가 올바른지 여부
+         */
+        bool Open(char const *path)
+        {
+            Close();
+            if (!Map(path))
+                return false;
+            TraceFileHeader header;
+            if (m_size >= sizeof(header))
+                std::memcpy(&header, m_pData, sizeof(header));
+            if (m_size < sizeof(header) || std::memcmp(header.magic, TraceFileHeader::Magic, sizeof(header.magic)) != 0
+                || header.version != TraceFileHeader::CurrentVersion)
+            {
+                Close();
+                return false;
+            }
+            BuildIndex();
+            return true;
+        }
+        /**
+         * @brief 매핑 해제
+         */
+        void Close()
+        {
+            Unmap();
+            m_index.clear();
+        }
+        /**
+         * @brief eventId 레코드를 재생할 때 호출할 이벤트 지정
+         *
+         * 매개변수는 기록할 때와 같은 타입으로 디코딩되므로 기록한 이벤트와 시그니처가 같아야 한다.
+         *
+         * @param eventId TraceRecorder에서 사용한 ID
+         * @param event 호출할 이벤트, 재생하는 동안 살아있어야 한다.
+         */
+        template <typename _R, typename... _Args, class _Instrument>
+        void Bind(std::uint32_t eventId, Event<_R(_Args...), _Instrument> &event)
+        {
+            using TargetEvent = Event<_R(_Args...), _Instrument>;
+            if (eventId >= m_bindings.size())
+                m_bindings.resize(eventId + 1);
+            m_bindings[eventId] = { [](void *pEvent, std::byte const *p)
+            {
+                // 중괄호 초기화는 왼쪽부터 평가되므로 기록한 순서대로 읽는다.
+                std::tuple<std::decay_t<_Args>...> args{ TraceSerializer<std::decay_t<_Args>>::Read(p)... };
+                std::apply([pEvent](auto &...values) { (*static_cast<TargetEvent *>(pEvent))(values...); }, args);
+            }, &event };
+        }
+        /**
+         * @brief eventId의 바인딩 해제, 이후 그 ID의 레코드는 건너뛴다.
+         */
+        void Unbind(std::uint32_t eventId)
+        {
+            if (eventId < m_bindings.size())
+                m_bindings[eventId] = {};
+        }
+        /**
+         * @brief 모든 레코드를 타임스탬프 순으로 호출
+         *
+         * RecordedSpeed에서는 재생을 시작한 시점을 첫 레코드의 시간으로 보고 각 레코드의 시간까지 기다렸다가 호출한다.\n
+         * 기다림은 sleep_until을 사용하므로 운영체제 타이머 해상도보다 가까운 레코드들은 몰아서 호출될 수 있다.
+         *
+         * @param mode 재생 속도
+         * @return ReplayReport 호출한 레코드 수와 처리량
+         */
+        ReplayReport Replay(ReplayMode mode = ReplayMode::AsFastAsPossible) const
+        {
+            ReplayReport report;
+            report.fireCounts.resize(m_bindings.size());
+            if (m_index.empty())
+                return report;
+            std::uint64_t firstTimestamp = m_index.front().timestamp;
+            report.recordedDuration = std::chrono::nanoseconds(m_index.back().timestamp - firstTimestamp);
+            auto begin = std::chrono::steady_clock::now();
+            for (auto const &entry : m_index)
+            {
+                TraceRecordHeader header;
+                std::memcpy(&header, m_pData + entry.offset, sizeof(header));
+                if (header.eventId >= m_bindings.size() || m_bindings[header.eventId].pfnFire == nullptr)
+                {
+                    ++report.nSkipped;
+                    continue;
+                }
+                if (mode == ReplayMode::RecordedSpeed)
+                {
+                    auto due = begin + std::chrono::nanoseconds(header.timestamp - firstTimestamp);
+                    if (std::chrono::steady_clock::now() < due)
+                        std::this_thread::sleep_until(due);
+                }
+                Binding const &binding = m_bindings[header.eventId];
+                binding.pfnFire(binding.pEvent, m_pData + entry.offset + sizeof(header));
+                ++report.nRecord;
+                report.nByte += sizeof(header) + header.size;
+                ++report.fireCounts[header.eventId];
+            }
+            report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+            return report;
+        }
+        bool IsOpen() const { return m_pData != nullptr; }
+        /**
+         * @brief 로그의 레코드 수
+         */
+        std::size_t GetRecordCount() const { return m_index.size(); }
+        /**
+         * @brief 매핑된 로그 크기(byte)
+         */
+        std::size_t GetFileSize() const { return m_size; }
+
+    private:
+        /**
+         * @brief 레코드들을 훑어 위치를 모으고 타임스탬프 순으로 정렬
+         *
+         * 같은 스레드의 레코드는 이미 시간 순이므로 같은 타임스탬프끼리는 파일 순서를 유지한다.
+         */
+        void BuildIndex()
+        {
+            std::size_t offset = sizeof(TraceFileHeader);
+            while (m_size - offset >= sizeof(TraceRecordHeader))
+            {
+                TraceRecordHeader header;
+                std::memcpy(&header, m_pData + offset, sizeof(header));
+                if (m_size - offset - sizeof(header) < header.size)
+                    break;
+                m_index.push_back({ header.timestamp, offset });
+                offset += sizeof(header) + header.size;
+            }
+            std::stable_sort(m_index.begin(), m_index.end(), [](IndexEntry const &a, IndexEntry const &b) { return a.timestamp < b.timestamp; });
+        }
+#ifdef _WIN32
+        bool Map(char const *path)
+        {
+            m_hFile = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_hFile == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(m_hFile, &size) && size.QuadPart != 0)
+                m_hMapping = ::CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_hMapping != nullptr)
+                m_pData = static_cast<std::byte const *>(::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+            if (m_pData == nullptr)
+            {
+                Unmap();
+                return false;
+            }
+            m_size = static_cast<std::size_t>(size.QuadPart);
+            return true;
+        }
+        void Unmap()
+        {
+            if (m_pData != nullptr)
+                ::UnmapViewOfFile(m_pData);
+            if (m_hMapping != nullptr)
+                ::CloseHandle(m_hMapping);
+            if (m_hFile != INVALID_HANDLE_VALUE)
+                ::CloseHandle(m_hFile);
+            m_pData = nullptr;
+            m_size = 0;
+            m_hMapping = nullptr;
+            m_hFile = INVALID_HANDLE_VALUE;
+        }
+
+        HANDLE m_hFile = INVALID_HANDLE_VALUE;
+        HANDLE m_hMapping = nullptr;
+#else
+        bool Map(char const *path)
+        {
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+            void *p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            // 매핑은 파일 디스크립터를 닫아도 유지된다.
+            ::close(fd);
+            if (p == MAP_FAILED)
+                return false;
+            ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+            m_pData = static_cast<std::byte const *>(p);
+            m_size = static_cast<std::size_t>(st.st_size);
+            return true;
+        }
+        void Unmap()
+        {
+            if (m_pData != nullptr)
+                ::munmap(const_cast<std::byte *>(m_pData), m_size);
+            m_pData = nullptr;
+            m_size = 0;
+        }
+#endif
+
+        std::byte const *m_pData = nullptr;
+        std::size_t m_size = 0;
+        std::vector<IndexEntry> m_index;
+        std::vector<Binding> m_bindings;
+    };
+}
@@ -0,0 +1,401 @@
+/**
+ * @file ysKeyedEvent.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 키별로 리스너를 나눠 해당 키의 리스너만 호출하는 이벤트
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <bit>
+#include <functional>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    template <class _Key, typename _FuncType, class _Hash = std::hash<_Key>, class _KeyEqual = std::equal_to<_Key>>
+    class KeyedEvent;
+
+    /**
+     * @brief 키별로 리스너를 나눠 해당 키의 리스너만 호출하는 이벤트
+     *
+     * 모든 리스너를 호출한 뒤 리스너마다 키를 비교해 걸러내는 대신, 키마다 Event 하나(버킷)를 두고
+     * 호출할 때는 평탄한 해시 색인으로 그 키의 버킷만 찾아 호출한다.\n
+     * 따라서 호출 비용은 전체 리스너 수가 아니라 그 키에 등록된 리스너 수에 비례한다.
+     * - 버킷은 Event이므로 키별 등록, 해제, 우선순위, 소유 객체 만료 정리, 호출 중 변경 규칙이 Event와 같다.
+     * - 와일드카드 리스너는 모든 키의 호출에서 그 키의 리스너들 다음에 호출된다.
+     *   키 리스너의 Propagation::Stop()은 그 키의 나머지 리스너에만 적용된다.
+     * - 색인은 (해시 조각, 버킷 인덱스) 쌍을 담은 선형 탐사 해시 테이블이며, 버킷은 deque에 있어 키가 늘어나도 옮겨지지 않는다.
+     *   따라서 리스너 안에서 다른 키에 등록하거나 같은 키를 다시 호출해도 안전하다.
+     *
+     * Event와 마찬가지로 스레드 안전하지 않다.
+     *
+     * ex) damaged.AddListener(entityId, OnDamaged); damaged(entityId, amount);
+     *
+     * @tparam _Key 키 타입
+     * @tparam _R 반환 타입
+     * @tparam _Args 매개변수 타입
+     * @tparam _Hash 키 해시 함수 객체 타입
+     * @tparam _KeyEqual 키 비교 함수 객체 타입
+     */
+    template <class _Key, typename _R, typename... _Args, class _Hash, class _KeyEqual>
+    class KeyedEvent<_Key, _R(_Args...), _Hash, _KeyEqual>
+    {
+    public:
+        /**
+         * @brief 키별 리스너를 담는 이벤트 타입
+         */
+        using BucketEvent = Event<_R(_Args...)>;
+
+    private:
+        struct Bucket
+        {
+            _Key key;
+            BucketEvent event;
+            bool bUsed;
+        };
+        /**
+         * @brief 색인 한 칸, 해시 조각을 먼저 비교해 버킷의 키를 읽는 횟수를 줄인다.
+         */
+        struct IndexEntry
+        {
+            std::uint32_t tag;
+            std::uint32_t bucket = EmptyBucket;
+        };
+        static constexpr std::uint32_t EmptyBucket = ~std::uint32_t(0);
+
+    public:
+/// @cond
+        KeyedEvent() = default;
+        KeyedEvent(KeyedEvent const &) = delete;
+        KeyedEvent(KeyedEvent &&) = default;
+        ~KeyedEvent() = default;
+        KeyedEvent& operator=(KeyedEvent const &) = delete;
+        KeyedEvent& operator=(KeyedEvent &&) = default;
+/// @endcond
+
+        /**
+         * @brief key에 리스너 등록
+         *
+         * 매개변수는 Event::AddListener에 그대로 전달되므로 함수 포인터, 멤버 함수, 호출 가능한 객체, 우선순위를 모두 사용할 수 있다.
+         *
+         * @param key 리스너를 등록할 키
+         * @param args Event::AddListener에 전달할 매개변수
+         * @return ListenerHandle key와 함께 등록 해제에 사용할 핸들
+         */
+        template <class... _Ts>
+        ListenerHandle AddListener(_Key const &key, _Ts &&...args)
+        {
+            return GetOrCreate(key).AddListener(std::forward<_Ts>(args)...);
+        }
+        /**
+         * @brief 모든 키의 호출에서 호출되는 와일드카드 리스너 등록
+         *
+         * @param args Event::AddListener에 전달할 매개변수
+         * @return ListenerHandle RemoveWildcardListener에 사용할 핸들
+         */
+        template <class... _Ts>
+        ListenerHandle AddWildcardListener(_Ts &&...args)
+        {
+            return m_wildcard.AddListener(std::forward<_Ts>(args)...);
+        }
+        /**
+         * @brief key에 등록된 리스너를 핸들로 등록 해제
+         *
+         * @param key 리스너를 등록한 키
+         * @param handle AddListener가 반환한 핸들
+         * @return 리스너가 해제되었는지 여부
+         */
+        bool RemoveListener(_Key const &key, ListenerHandle handle)
+        {
+            BucketEvent *pEvent = Find(key);
+            return pEvent != nullptr && pEvent->RemoveListener(handle);
+        }
+        /**
+         * @brief key에 등록된 리스너를 등록할 때와 같은 값으로 등록 해제
+         *
+         * @param key 리스너를 등록한 키
+         * @param args Event::RemoveListener에 전달할 매개변수
+         */
+        template <class... _Ts>
+        void RemoveListener(_Key const &key, _Ts &&...args)
+        {
+            if (BucketEvent *pEvent = Find(key))
+                pEvent->RemoveListener(std::forward<_Ts>(args)...);
+        }
+        /**
+         * @brief 와일드카드 리스너 등록 해제
+         *
+         * @param handle AddWildcardListener가 반환한 핸들
+         * @return 리스너가 해제되었는지 여부
+         */
+        bool RemoveWildcardListener(ListenerHandle handle) { return m_wildcard.RemoveListener(handle); }
+        /**
+         * @brief key의 리스너들을 모두 등록 해제하고 버킷을 반납
+         *
+         * 반납된 버킷은 이후 새 키에 재사용된다.
+         *
+         * @param key 비울 키
+         * @return 키가 있었는지 여부
+         */
+        bool RemoveKey(_Key const &key)
+        {
+            std::size_t pos = FindIndex(key);
+            if (pos == m_index.size())
+                return false;
+            std::uint32_t bucket = m_index[pos].bucket;
+            EraseIndex(pos);
+            m_buckets[bucket].event.RemoveAllListener();
+            m_buckets[bucket].bUsed = false;
+            m_freeBuckets.push_back(bucket);
+            --m_nKey;
+            return true;
+        }
+        /**
+         * @brief 모든 키와 와일드카드의 리스너들을 등록 해제
+         */
+        void RemoveAllListener()
+        {
+            for (auto &bucket : m_buckets)
+                if (bucket.bUsed)
+                    RemoveKey(bucket.key);
+            m_wildcard.RemoveAllListener();
+        }
+        /**
+         * @brief 리스너가 남지 않은 키들의 버킷을 반납
+         *
+         * @return 반납된 키 수
+         */
+        std::size_t RemoveEmptyKeys()
+        {
+            std::size_t nRemoved = 0;
+            for (auto &bucket : m_buckets)
+                if (bucket.bUsed && bucket.event.GetListenerCount() == 0 && RemoveKey(bucket.key))
+                    ++nRemoved;
+            return nRemoved;
+        }
+        /**
+         * @brief 모든 버킷에서 소유 객체가 소멸된 리스너들을 찾아 제거
+         *
+         * @return 제거된 리스너 수
+         */
+        std::size_t PruneExpired()
+        {
+            std::size_t nPruned = m_wildcard.PruneExpired();
+            for (auto &bucket : m_buckets)
+                if (bucket.bUsed)
+                    nPruned += bucket.event.PruneExpired();
+            return nPruned;
+        }
+
+        /**
+         * @brief key의 리스너들과 와일드카드 리스너들을 호출
+         *
+         * @param key 호출할 키
+         * @param args 함수 호출에 필요한 매개변수
+         */
+        void operator()(_Key const &key, EventArg<_Args>... args) const
+            requires(std::is_void_v<_R>)
+        {
+            if (BucketEvent const *pEvent = Find(key))
+                (*pEvent)(std::forward<EventArg<_Args>>(args)...);
+            if (m_wildcard.GetListenerCount() != 0)
+                m_wildcard(std::forward<EventArg<_Args>>(args)...);
+        }
+        /**
+         * @brief key의 리스너들과 와일드카드 리스너들의 반환 값을 결합기로 합치는 함수 호출
+         *
+         * 두 이벤트는 결합기 하나를 이어서 사용하므로, key의 리스너에서 결합기가 중단을 요청했다면(First, Or, And 등) 와일드카드 리스너는 호출되지 않는다.\n
+         * ex) keyed.Invoke<Combiner::Sum>(key, args...)
+         *
+         * @tparam _Combiner 반환 타입으로 인스턴스화할 결합기 템플릿
+         * @param key 호출할 키
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 결합기의 GetResult() 결과
+         */
+        template <template <typename> class _Combiner>
+            requires(non_void<_R> && result_combiner<_Combiner<_R>, _R>)
+        auto Invoke(_Key const &key, EventArg<_Args>... args) const
+        {
+            _Combiner<_R> combiner;
+            StopTracker<_Combiner<_R>> tracker{ combiner };
+            if (BucketEvent const *pEvent = Find(key))
+                pEvent->Invoke(tracker, std::forward<EventArg<_Args>>(args)...);
+            if (!tracker.bStopped)
+                m_wildcard.Invoke(combiner, std::forward<EventArg<_Args>>(args)...);
+            return combiner.GetResult();
+        }
+
+        /**
+         * @brief key의 버킷 이벤트, 키가 없다면 nullptr
+         *
+         * 버킷에서 직접 우선순위, 핸들 확인 등 Event의 기능을 사용할 때 쓴다.
+         */
+        BucketEvent *Find(_Key const &key)
+        {
+            std::size_t pos = FindIndex(key);
+            return pos != m_index.size() ? &m_buckets[m_index[pos].bucket].event : nullptr;
+        }
+        BucketEvent const *Find(_Key const &key) const { return const_cast<KeyedEvent *>(this)->Find(key); }
+        /**
+         * @brief 와일드카드 리스너들을 담은 이벤트
+         */
+        BucketEvent &GetWildcard() { return m_wildcard; }
+        BucketEvent const &GetWildcard() const { return m_wildcard; }
+        /**
+         * @brief key에 등록된 리스너 수, 와일드카드 리스너는 세지 않는다.
+         */
+        std::size_t GetListenerCount(_Key const &key) const
+        {
+            BucketEvent const *pEvent = Find(key);
+            return pEvent != nullptr ? pEvent->GetListenerCount() : 0;
+        }
+        /**
+         * @brief 모든 키와 와일드카드에 등록된 리스너 수
+         */
+        std::size_t GetListenerCount() const
+        {
+            std::size_t count = m_wildcard.GetListenerCount();
+            for (auto &bucket : m_buckets)
+                if (bucket.bUsed)
+                    count += bucket.event.GetListenerCount();
+            return count;
+        }
+        /**
+         * @brief 버킷이 있는 키 수
+         */
+        std::size_t GetKeyCount() const { return m_nKey; }
+        /**
+         * @brief 키드 이벤트가 사용 중인 메모리 크기(byte)
+         *
+         * 색인과 반납된 버킷 목록의 용량, 모든 버킷 이벤트의 MemoryUsage 합이다.
+         */
+        std::size_t MemoryUsage() const
+        {
+            std::size_t size = sizeof(*this) + m_index.capacity() * sizeof(IndexEntry) + m_freeBuckets.capacity() * sizeof(std::uint32_t);
+            size += m_wildcard.MemoryUsage() - sizeof(BucketEvent);
+            for (auto &bucket : m_buckets)
+                size += sizeof(Bucket) - sizeof(BucketEvent) + bucket.event.MemoryUsage();
+            return size;
+        }
+
+    private:
+        /**
+         * @brief 결합기에 반환 값을 넘기며 결합기가 중단을 요청했는지 기록하는 래퍼
+         */
+        template <class _C>
+        struct StopTracker
+        {
+            _C &combiner;
+            bool bStopped = false;
+
+            bool operator()(_R &&value)
+            {
+                bStopped = !static_cast<bool>(combiner(std::move(value)));
+                return !bStopped;
+            }
+            void GetResult() const {}
+        };
+        /**
+         * @brief 키의 해시를 피보나치 해싱으로 섞는다.
+         *
+         * 정수 ID처럼 항등 해시를 쓰는 키도 색인 전체에 고르게 퍼지도록 상위 비트를 색인 위치로, 하위 비트를 해시 조각으로 쓴다.
+         */
+        std::uint64_t Mix(_Key const &key) const { return static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull; }
+        std::size_t Home(std::uint64_t mixed) const { return static_cast<std::size_t>(mixed >> m_shift); }
+        /**
+         * @brief key가 있는 색인 위치, 없다면 m_index.size()
+         */
+        std::size_t FindIndex(_Key const &key) const
+        {
+            if (m_nKey == 0)
+                return m_index.size();
+            std::uint64_t mixed = Mix(key);
+            std::uint32_t tag = static_cast<std::uint32_t>(mixed);
+            std::size_t mask = m_index.size() - 1;
+            for (std::size_t pos = Home(mixed);; pos = (pos + 1) & mask)
+            {
+                IndexEntry const &entry = m_index[pos];
+                if (entry.bucket == EmptyBucket)
+                    return m_index.size();
+                if (entry.tag == tag && m_keyEqual(m_buckets[entry.bucket].key, key))
+                    return pos;
+            }
+        }
+        /**
+         * @brief key의 버킷 이벤트, 없다면 반납된 버킷을 재사용하거나 새로 만든다.
+         */
+        BucketEvent &GetOrCreate(_Key const &key)
+        {
+            if (BucketEvent *pEvent = Find(key))
+                return *pEvent;
+            // 색인의 절반 넘게 차면 두 배로 늘린다.
+            if ((m_nKey + 1) * 2 > m_index.size())
+                Rehash(m_index.empty() ? 16 : m_index.size() * 2);
+            std::uint32_t bucket;
+            if (!m_freeBuckets.empty())
+            {
+                bucket = m_freeBuckets.back();
+                m_freeBuckets.pop_back();
+                m_buckets[bucket].key = key;
+                m_buckets[bucket].bUsed = true;
+            }
+            else
+            {
+                bucket = static_cast<std::uint32_t>(m_buckets.size());
+                m_buckets.push_back({ key, BucketEvent(), true });
+            }
+            InsertIndex(Mix(key), bucket);
+            ++m_nKey;
+            return m_buckets[bucket].event;
+        }
+        void InsertIndex(std::uint64_t mixed, std::uint32_t bucket)
+        {
+            std::size_t mask = m_index.size() - 1;
+            std::size_t pos = Home(mixed);
+            while (m_index[pos].bucket != EmptyBucket)
+                pos = (pos + 1) & mask;
+            m_index[pos] = { static_cast<std::uint32_t>(mixed), bucket };
+        }
+        /**
+         * @brief 색인에서 pos를 지우고 뒤따르는 항목들을 당겨 탐사 경로를 유지한다. (backward shift)
+         */
+        void EraseIndex(std::size_t pos)
+        {
+            std::size_t mask = m_index.size() - 1;
+            std::size_t next = (pos + 1) & mask;
+            while (m_index[next].bucket != EmptyBucket)
+            {
+                std::size_t home = Home(Mix(m_buckets[m_index[next].bucket].key));
+                // next의 원래 자리가 (pos, next] 구간 밖이라면 pos로 당겨도 탐사 경로가 끊기지 않는다.
+                if (((next - home) & mask) >= ((next - pos) & mask))
+                {
+                    m_index[pos] = m_index[next];
+                    pos = next;
+                }
+                next = (next + 1) & mask;
+            }
+            m_index[pos] = {};
+        }
+        void Rehash(std::size_t size)
+        {
+            m_index.assign(size, {});
+            m_shift = 64 - std::countr_zero(size);
+            for (std::uint32_t bucket = 0; bucket < m_buckets.size(); ++bucket)
+                if (m_buckets[bucket].bUsed)
+                    InsertIndex(Mix(m_buckets[bucket].key), bucket);
+        }
+
+        std::vector<IndexEntry> m_index;
+        std::deque<Bucket> m_buckets;
+        std::vector<std::uint32_t> m_freeBuckets;
+        std::size_t m_nKey = 0;
+        int m_shift = 64;
+        BucketEvent m_wildcard;
+        [[no_unique_address]] _Hash m_hash;
+        [[no_unique_address]] _KeyEqual m_keyEqual;
+    };
+}
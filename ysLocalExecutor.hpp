@@ -0,0 +1,179 @@
+/**
+ * @file ysLocalExecutor.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 호출한 스레드에서 직접 시간을 진행시키는 타이머 실행기
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+
+namespace YS
+{
+    /**
+     * @brief 호출한 스레드에서 직접 시간을 진행시키는 타이머 실행기
+     *
+     * 실행기의 현재 시간은 AdvanceTo, AdvanceBy, Poll을 호출할 때만 흐르며, 그때 마감 시간이 지난 타이머들을 마감 순서대로 실행한다.\n
+     * 따라서 테스트에서는 실제 시간을 기다리지 않고 원하는 만큼 시간을 진행시킬 수 있고,
+     * 실제 시간으로 사용하려면 Clock::now()로 생성한 뒤 주기적으로 Poll을 호출한다.\n
+     * 타이머는 사용하는 쪽이 소유하는 침습형 노드이므로 예약할 때 할당이 일어나지 않는다.\n
+     * 스레드 안전하지 않으므로 한 스레드에서만 사용해야 한다.
+     *
+     * ex) co_await event.Next(executor, 10ms);
+     */
+    class LocalExecutor
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+        using Duration = Clock::duration;
+
+        /**
+         * @brief 실행기에 예약할 수 있는 타이머
+         *
+         * 예약된 채로 소멸되면 안되므로 소유자는 소멸 전에 Cancel을 호출해야 한다.
+         */
+        class Timer
+        {
+            friend LocalExecutor;
+        public:
+            /**
+             * @param pfnExpire 마감 시간이 되었을 때 호출할 함수, 호출 전에 예약이 해제되므로 안에서 타이머를 소멸시키거나 다시 예약해도 된다.
+             * @param pContext pfnExpire에 전달할 값
+             */
+            Timer(void (*pfnExpire)(void *pContext), void *pContext) : m_pfnExpire(pfnExpire), m_pContext(pContext) {}
+            Timer(Timer const &) = delete;
+            Timer& operator=(Timer const &) = delete;
+
+            /**
+             * @brief 예약되어 있는지 여부
+             */
+            bool IsScheduled() const { return m_pPrev != nullptr; }
+            /**
+             * @brief 예약된 마감 시간
+             */
+            TimePoint GetDeadline() const { return m_deadline; }
+
+        private:
+            void (*m_pfnExpire)(void *pContext);
+            void *m_pContext;
+            TimePoint m_deadline;
+            Timer *m_pPrev = nullptr;
+            Timer *m_pNext = nullptr;
+        };
+
+/// @cond
+        explicit LocalExecutor(TimePoint now = TimePoint()) : m_now(now) { m_head.m_pPrev = m_head.m_pNext = &m_head; }
+        LocalExecutor(LocalExecutor const &) = delete;
+        ~LocalExecutor() { CancelAll(); }
+        LocalExecutor& operator=(LocalExecutor const &) = delete;
+/// @endcond
+
+        /**
+         * @brief 실행기의 현재 시간
+         */
+        TimePoint Now() const { return m_now; }
+        /**
+         * @brief 현재 시간으로부터 delay 뒤에 실행되도록 타이머 예약
+         *
+         * 이미 예약된 타이머라면 마감 시간을 옮긴다.
+         *
+         * @param timer 예약할 타이머
+         * @param delay 현재 시간으로부터의 지연 시간
+         */
+        void Schedule(Timer &timer, Duration delay) { ScheduleAt(timer, m_now + delay); }
+        /**
+         * @brief deadline에 실행되도록 타이머 예약
+         *
+         * 마감 시간이 같은 타이머들은 예약한 순서대로 실행된다.
+         *
+         * @param timer 예약할 타이머
+         * @param deadline 마감 시간
+         */
+        void ScheduleAt(Timer &timer, TimePoint deadline)
+        {
+            Cancel(timer);
+            timer.m_deadline = deadline;
+            // 마감 시간 순으로 정렬된 목록의 뒤에서부터 찾는다. 보통 새 타이머는 가장 늦게 끝난다.
+            Timer *pPrev = m_head.m_pPrev;
+            while (pPrev != &m_head && deadline < pPrev->m_deadline)
+                pPrev = pPrev->m_pPrev;
+            timer.m_pPrev = pPrev;
+            timer.m_pNext = pPrev->m_pNext;
+            pPrev->m_pNext->m_pPrev = &timer;
+            pPrev->m_pNext = &timer;
+            ++m_nTimer;
+        }
+        /**
+         * @brief 타이머 예약 취소, 예약되지 않은 타이머라면 아무 일도 일어나지 않는다.
+         *
+         * @param timer 취소할 타이머
+         */
+        void Cancel(Timer &timer)
+        {
+            if (!timer.IsScheduled())
+                return;
+            timer.m_pPrev->m_pNext = timer.m_pNext;
+            timer.m_pNext->m_pPrev = timer.m_pPrev;
+            timer.m_pPrev = timer.m_pNext = nullptr;
+            --m_nTimer;
+        }
+        /**
+         * @brief 모든 타이머 예약 취소
+         */
+        void CancelAll()
+        {
+            while (m_head.m_pNext != &m_head)
+                Cancel(*m_head.m_pNext);
+        }
+        /**
+         * @brief 현재 시간을 now로 진행시키며 마감 시간이 지난 타이머들을 실행
+         *
+         * 타이머가 실행되는 동안 현재 시간은 그 타이머의 마감 시간이며, 실행 중에 예약된 타이머도 마감 시간이 now 이전이라면 함께 실행된다.\n
+         * now가 현재 시간보다 이전이라면 시간은 되돌아가지 않는다.
+         *
+         * @param now 진행시킬 시간
+         * @return 실행된 타이머 수
+         */
+        std::size_t AdvanceTo(TimePoint now)
+        {
+            std::size_t nExpired = 0;
+            while (m_head.m_pNext != &m_head && m_head.m_pNext->m_deadline <= now)
+            {
+                Timer &timer = *m_head.m_pNext;
+                m_now = std::max(m_now, timer.m_deadline);
+                Cancel(timer);
+                ++nExpired;
+                timer.m_pfnExpire(timer.m_pContext);
+            }
+            m_now = std::max(m_now, now);
+            return nExpired;
+        }
+        /**
+         * @brief 현재 시간을 delay만큼 진행시키며 마감 시간이 지난 타이머들을 실행
+         *
+         * @param delay 진행시킬 시간
+         * @return 실행된 타이머 수
+         */
+        std::size_t AdvanceBy(Duration delay) { return AdvanceTo(m_now + delay); }
+        /**
+         * @brief 현재 시간을 Clock::now()로 진행시키며 마감 시간이 지난 타이머들을 실행
+         *
+         * @return 실행된 타이머 수
+         */
+        std::size_t Poll() { return AdvanceTo(Clock::now()); }
+        /**
+         * @brief 예약된 타이머 수
+         */
+        std::size_t GetTimerCount() const { return m_nTimer; }
+
+    private:
+        // 마감 시간 순으로 정렬된 원형 목록의 머리, 콜백은 사용하지 않는다.
+        Timer m_head{ nullptr, nullptr };
+        TimePoint m_now;
+        std::size_t m_nTimer = 0;
+    };
+}
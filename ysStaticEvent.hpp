@@ -0,0 +1,164 @@
+/**
+ * @file ysStaticEvent.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 컴파일 타임에 리스너가 정해지는 이벤트
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <array>
+#include <tuple>
+#include "ysEvent.hpp"
+
+namespace YS
+{
+    /**
+     * @brief 정적 이벤트에 템플릿 인자로 넘긴 리스너의 소유 객체 타입을 구하기 위한 클래스
+     * 
+     * 비멤버 함수라면 소유 객체가 없으므로 void이다.
+     * 
+     * @tparam _T 리스너 타입
+     */
+    template <typename _T> struct StaticListenerOwner { using type = void; };
+    template <class _C, typename _R, typename... _Args> struct StaticListenerOwner<MemFnPtr<_C, _R, _Args...>> { using type = _C; };
+    template <class _C, typename _R, typename... _Args> struct StaticListenerOwner<ConstMemFnPtr<_C, _R, _Args...>> { using type = _C const; };
+
+    /**
+     * @brief 정적 이벤트 리스너가 될 수 있는 타입인지 확인하는 컨셉
+     * 
+     * 비멤버 함수 포인터이거나 이벤트와 같은 형식의 비상수/상수 멤버 함수 포인터여야 한다.
+     */
+    template <auto _Listener, typename _R, typename... _Args>
+    concept static_listener = std::same_as<decltype(_Listener), FnPtr<_R, _Args...>>
+        || std::same_as<decltype(_Listener), MemFnPtr<std::remove_const_t<typename StaticListenerOwner<decltype(_Listener)>::type>, _R, _Args...>>
+        || std::same_as<decltype(_Listener), ConstMemFnPtr<std::remove_const_t<typename StaticListenerOwner<decltype(_Listener)>::type>, _R, _Args...>>;
+
+    /**
+     * @brief 정적 이벤트 기반 클래스
+     * 
+     * @tparam _FuncType 함수의 타입
+     * @tparam _Listeners 등록할 함수 포인터, 멤버 함수 포인터들
+     */
+    template <typename _FuncType, auto... _Listeners>
+    class StaticEvent;
+
+    /**
+     * @brief 정적 이벤트 클래스
+     * 
+     * 리스너를 템플릿 인자로 받아 컴파일 타임에 고정한다.\n
+     * 호출은 가상 호출이나 함수 포인터를 거치지 않고 리스너들을 차례로 직접 호출하는 코드가 되므로 컴파일러가 인라인할 수 있다.\n
+     * 멤버 함수 리스너가 호출할 객체는 생성자에서 멤버 함수 리스너 순서대로 받으며,
+     * 성능을 위해 잠그지 않고 포인터로만 들고 있으므로 객체가 이벤트보다 오래 살아있어야 한다.
+     * 
+     * ex) StaticEvent<void(int), &OnTick, SelectNonConstFn(&foo::OnTick)> tick(fooObj);
+     * 
+     * @tparam _R 반환 타입
+     * @tparam _Args 매개변수 타입
+     * @tparam _Listeners 등록할 함수 포인터, 멤버 함수 포인터들
+     */
+    template <typename _R, typename... _Args, auto... _Listeners>
+    class StaticEvent<_R(_Args...), _Listeners...>
+    {
+        static_assert((static_listener<_Listeners, _R, _Args...> && ...), "StaticEvent listener must match the event signature");
+
+#pragma region Type Define
+        template <auto _Listener>
+        using OwnerType = typename StaticListenerOwner<decltype(_Listener)>::type;
+        template <auto _Listener>
+        using OwnerTuple = std::conditional_t<std::is_void_v<OwnerType<_Listener>>, std::tuple<>, std::tuple<OwnerType<_Listener> *>>;
+        using Owners = decltype(std::tuple_cat(std::declval<OwnerTuple<_Listeners>>()...));
+#pragma endregion
+
+        static constexpr std::size_t ListenerCount = sizeof...(_Listeners);
+        static constexpr std::tuple<decltype(_Listeners)...> s_listeners{ _Listeners... };
+        /**
+         * @brief 각 멤버 함수 리스너가 Owners에서 몇 번째 객체를 쓰는지 구한다.
+         */
+        static constexpr std::array<std::size_t, ListenerCount> s_ownerIndices = []()
+        {
+            std::array<std::size_t, ListenerCount> indices{};
+            bool const isMember[] = { !std::is_void_v<OwnerType<_Listeners>>..., false };
+            std::size_t nOwner = 0;
+            for (std::size_t i = 0; i < ListenerCount; ++i)
+                indices[i] = isMember[i] ? nOwner++ : 0;
+            return indices;
+        }();
+
+    public:
+        /**
+         * @brief 정적 이벤트 생성
+         * 
+         * @param owners 멤버 함수 리스너들을 호출할 객체, 멤버 함수 리스너 순서대로 넘긴다.
+         */
+        template <class... _Owners>
+            requires(std::is_constructible_v<Owners, _Owners *...>)
+        explicit StaticEvent(_Owners &...owners) : m_owners(&owners...) {}
+
+        /**
+         * @brief 반환값이 존재하는 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 등록 순서대로 담긴 함수의 반환 값
+         */
+        std::array<_R, ListenerCount> operator()(EventArg<_Args>... args) const
+            requires(non_void<_R>)
+        {
+            return CallAll(std::make_index_sequence<ListenerCount>(), std::forward<EventArg<_Args>>(args)...);
+        }
+        /**
+         * @brief 반환값이 존재하지 않는 함수 타입에 대한 함수 호출
+         * 
+         * @param args 함수 호출에 필요한 매개변수
+         */
+        void operator()(EventArg<_Args>... args) const
+        {
+            CallAll(std::make_index_sequence<ListenerCount>(), std::forward<EventArg<_Args>>(args)...);
+        }
+        /**
+         * @brief 결합기로 반환 값들을 합치는 함수 호출
+         * 
+         * @tparam _Combiner 반환 타입으로 인스턴스화할 결합기 템플릿
+         * @param args 함수 호출에 필요한 매개변수
+         * @return 결합기의 GetResult() 결과
+         */
+        template <template <typename> class _Combiner>
+            requires(non_void<_R> && result_combiner<_Combiner<_R>, _R>)
+        auto Invoke(EventArg<_Args>... args) const
+        {
+            _Combiner<_R> combiner;
+            CombineAll(combiner, std::make_index_sequence<ListenerCount>(), std::forward<EventArg<_Args>>(args)...);
+            return combiner.GetResult();
+        }
+        /**
+         * @brief 등록된 리스너 수
+         */
+        static constexpr std::size_t GetListenerCount() { return ListenerCount; }
+
+    private:
+        template <std::size_t _I>
+        _R CallOne(EventArg<_Args>... args) const
+        {
+            constexpr auto pListener = std::get<_I>(s_listeners);
+            if constexpr (std::is_void_v<OwnerType<pListener>>)
+                return pListener(std::forward<EventArg<_Args>>(args)...);
+            else
+                return (std::get<s_ownerIndices[_I]>(m_owners)->*pListener)(std::forward<EventArg<_Args>>(args)...);
+        }
+        template <std::size_t... _I>
+        auto CallAll(std::index_sequence<_I...>, EventArg<_Args>... args) const
+        {
+            if constexpr (std::is_void_v<_R>)
+                (CallOne<_I>(args...), ...);
+            else
+                return std::array<_R, ListenerCount>{ CallOne<_I>(args...)... };
+        }
+        template <class _Combiner, std::size_t... _I>
+        void CombineAll(_Combiner &combiner, std::index_sequence<_I...>, EventArg<_Args>... args) const
+        {
+            (static_cast<bool>(combiner(CallOne<_I>(args...))) && ...);
+        }
+
+        Owners m_owners;
+    };
+}
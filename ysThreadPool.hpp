@@ -0,0 +1,201 @@
+/**
+ * @file ysThreadPool.hpp
+ * @author 최윤서 (choicoco1995@naver.com)
+ * @brief 이벤트 병렬 호출에 사용하는 작업 훔치기 스레드 풀
+ * @version 1.0.0
+ * @date 2023-01-30
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace YS
+{
+    /**
+     * @brief 작업 훔치기(work-stealing) 스레드 풀
+     * 
+     * 스레드마다 작업 덱을 두고 자기 덱은 뒤에서, 다른 스레드의 덱은 앞에서 가져가 실행한다.\n
+     * ParallelFor를 호출한 스레드도 작업이 끝날 때까지 함께 작업을 훔쳐 실행한다.
+     */
+    class ThreadPool
+    {
+        /**
+         * @brief [begin, end) 범위를 처리하는 작업 하나
+         */
+        struct Task
+        {
+            void (*pfnRun)(void *pContext, std::size_t begin, std::size_t end);
+            void *pContext;
+            std::size_t begin;
+            std::size_t end;
+        };
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+        /**
+         * @brief ParallelFor 한 번의 진행 상태
+         */
+        template <class _Fn>
+        struct Batch
+        {
+            ThreadPool *pPool;
+            _Fn &fn;
+            std::atomic<std::size_t> nRemaining;
+            std::atomic<bool> bFailed = false;
+            std::exception_ptr pException;
+
+            static void Run(void *pContext, std::size_t begin, std::size_t end)
+            {
+                auto &batch = *static_cast<Batch *>(pContext);
+                try { batch.fn(begin, end); }
+                catch (...)
+                {
+                    if (!batch.bFailed.exchange(true))
+                        batch.pException = std::current_exception();
+                }
+                // 마지막 조각이 끝나면 호출한 스레드가 바로 batch를 해제할 수 있으므로 그 전에 풀을 꺼내둔다.
+                ThreadPool *pPool = batch.pPool;
+                batch.nRemaining.fetch_sub(1, std::memory_order_acq_rel);
+                pPool->m_doneSignal.fetch_add(1, std::memory_order_release);
+                pPool->m_doneSignal.notify_all();
+            }
+        };
+
+    public:
+        /**
+         * @brief 스레드 풀 생성
+         * 
+         * @param nThread 작업 스레드 수, 0이라면 하드웨어 스레드 수 - 1 (최소 1)
+         */
+        explicit ThreadPool(std::size_t nThread = 0)
+        {
+            if (nThread == 0)
+                nThread = std::max(1u, std::thread::hardware_concurrency()) - 1;
+            nThread = std::max<std::size_t>(nThread, 1);
+            m_workers.reserve(nThread + 1);
+            for (std::size_t i = 0; i <= nThread; ++i)
+                m_workers.push_back(std::make_unique<Worker>());
+            m_threads.reserve(nThread);
+            for (std::size_t i = 0; i < nThread; ++i)
+                m_threads.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+        ThreadPool(ThreadPool const &) = delete;
+        ~ThreadPool()
+        {
+            m_bStop.store(true);
+            m_signal.fetch_add(1);
+            m_signal.notify_all();
+            for (auto &thread : m_threads)
+                thread.join();
+        }
+        ThreadPool& operator=(ThreadPool const &) = delete;
+
+        /**
+         * @brief [0, count) 범위를 grain 크기 조각으로 나눠 병렬로 fn(begin, end) 호출
+         * 
+         * 모든 조각이 끝날 때까지 반환하지 않는다.\n
+         * fn이 예외를 던지면 나머지 조각은 그대로 실행되고, 처음 잡힌 예외를 호출한 스레드에서 다시 던진다.
+         * 
+         * @param count 처리할 전체 개수
+         * @param grain 한 조각의 최대 크기, 0이라면 스레드 수에 맞춰 정한다.
+         * @param fn 조각을 처리할 함수 객체
+         */
+        template <class _Fn>
+        void ParallelFor(std::size_t count, std::size_t grain, _Fn &&fn)
+        {
+            if (count == 0)
+                return;
+            if (grain == 0)
+                grain = std::max<std::size_t>(1, count / (m_workers.size() * 4));
+            using BatchType = Batch<std::remove_reference_t<_Fn>>;
+            std::size_t nTask = (count + grain - 1) / grain;
+            BatchType batch{ this, fn, nTask, false, nullptr };
+            for (std::size_t i = 0; i < nTask; ++i)
+            {
+                auto &worker = *m_workers[m_nextWorker++ % m_workers.size()];
+                std::lock_guard lock(worker.mutex);
+                worker.tasks.push_back({ &BatchType::Run, &batch, i * grain, std::min(count, (i + 1) * grain) });
+            }
+            m_signal.fetch_add(1, std::memory_order_release);
+            m_signal.notify_all();
+
+            // 호출한 스레드는 마지막 덱을 자기 덱으로 쓰며 함께 처리한다.
+            for (;;)
+            {
+                auto done = m_doneSignal.load(std::memory_order_acquire);
+                if (batch.nRemaining.load(std::memory_order_acquire) == 0)
+                    break;
+                if (!RunOne(m_workers.size() - 1))
+                    m_doneSignal.wait(done, std::memory_order_acquire);
+            }
+            if (batch.pException)
+                std::rethrow_exception(batch.pException);
+        }
+        /**
+         * @brief 작업 스레드 수 (ParallelFor를 호출한 스레드 제외)
+         */
+        std::size_t GetThreadCount() const { return m_threads.size(); }
+
+    private:
+        /**
+         * @brief 자기 덱의 뒤나 다른 덱의 앞에서 작업 하나를 가져와 실행
+         * 
+         * @return 작업을 실행했는지 여부
+         */
+        bool RunOne(std::size_t self)
+        {
+            Task task;
+            bool bFound = false;
+            {
+                auto &worker = *m_workers[self];
+                std::lock_guard lock(worker.mutex);
+                if (!worker.tasks.empty())
+                {
+                    task = worker.tasks.back();
+                    worker.tasks.pop_back();
+                    bFound = true;
+                }
+            }
+            for (std::size_t i = 1; !bFound && i < m_workers.size(); ++i)
+            {
+                auto &victim = *m_workers[(self + i) % m_workers.size()];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    bFound = true;
+                }
+            }
+            if (bFound)
+                task.pfnRun(task.pContext, task.begin, task.end);
+            return bFound;
+        }
+        void WorkerLoop(std::size_t self)
+        {
+            while (!m_bStop.load(std::memory_order_acquire))
+            {
+                auto signal = m_signal.load(std::memory_order_acquire);
+                if (!RunOne(self))
+                    m_signal.wait(signal, std::memory_order_acquire);
+            }
+        }
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+        std::atomic<std::uint32_t> m_signal = 0;
+        std::atomic<std::uint32_t> m_doneSignal = 0;
+        std::atomic<bool> m_bStop = false;
+        std::atomic<std::size_t> m_nextWorker = 0;
+    };
+}